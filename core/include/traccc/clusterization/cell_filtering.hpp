@@ -0,0 +1,64 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2022 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+#pragma once
+
+// Library include(s).
+#include "traccc/clusterization/clusterization_config.hpp"
+#include "traccc/edm/cell.hpp"
+#include "traccc/geometry/pixel_mask.hpp"
+#include "traccc/utils/algorithm.hpp"
+
+namespace traccc {
+
+/// Removal of the cells on masked pixels, and of the cells below threshold
+///
+/// Drops all cells on masked (noisy or dead) pixels, and (unless
+/// @c traccc::clusterization_config::filter_below_threshold is switched
+/// off) all cells with a signal not above the threshold of their module.
+/// This way these cells don't need to go through connected component
+/// labelling at all.
+///
+/// Note that this changes the clusters found afterwards. Measurement
+/// creation ignores the cells below threshold, but connected component
+/// labelling does not: such a cell can connect two groups of cells above
+/// threshold into a single cluster. Once it is removed, the two groups
+/// become separate clusters, and give separate measurements.
+///
+/// The cells of every module are compacted in place, keeping their order,
+/// and the modules left without any cells are removed from the container.
+/// The @c range0 and @c range1 members of the module headers are updated to
+/// describe the remaining cells.
+///
+class cell_filtering : public algorithm<cell_container_types::host(
+                           cell_container_types::host&&)> {
+
+    public:
+    /// Constructor for cell_filtering
+    ///
+    /// @param mask is the set of pixels to remove the cells of
+    /// @param config is the clusterization configuration
+    ///
+    cell_filtering(const pixel_mask& mask = {},
+                   const clusterization_config& config = {});
+
+    /// Filter the cells of every module
+    ///
+    /// @param cells The cells for every detector module in the event
+    /// @return The cells that passed the filtering
+    ///
+    output_type operator()(cell_container_types::host&& cells) const override;
+
+    private:
+    /// The masked pixels
+    pixel_mask m_mask;
+    /// The clusterization configuration
+    clusterization_config m_config;
+
+};  // class cell_filtering
+
+}  // namespace traccc
@@ -0,0 +1,51 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2022 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+#pragma once
+
+// Library include(s).
+#include "traccc/clusterization/clusterization_config.hpp"
+#include "traccc/edm/cell.hpp"
+#include "traccc/utils/algorithm.hpp"
+
+namespace traccc {
+
+/// Sorting of the cells of every module into column major order
+///
+/// The clusterization algorithms require the cells of every module to be
+/// sorted by @c channel1. This algorithm sorts them by (@c channel1,
+/// @c channel0) with a least significant digit radix sort, in linear time,
+/// so that cells from any source can be clusterized.
+///
+/// The modules are sorted in place, using one scratch buffer shared by all
+/// modules, possibly on multiple threads. As a by-product the @c range0 and
+/// @c range1 members of the module headers are set as well.
+///
+class cell_sorting : public algorithm<cell_container_types::host(
+                         cell_container_types::host&&)> {
+
+    public:
+    /// Constructor for cell_sorting
+    ///
+    /// @param config is the clusterization configuration
+    ///
+    cell_sorting(const clusterization_config& config = {});
+
+    /// Sort the cells of every module
+    ///
+    /// @param cells The cells for every detector module in the event
+    /// @return The same cells, sorted in column major order
+    ///
+    output_type operator()(cell_container_types::host&& cells) const override;
+
+    private:
+    /// The clusterization configuration
+    clusterization_config m_config;
+
+};  // class cell_sorting
+
+}  // namespace traccc
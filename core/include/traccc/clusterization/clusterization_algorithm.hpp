@@ -8,10 +8,12 @@
 #pragma once
 
 // Library include(s).
-#include "traccc/clusterization/component_connection.hpp"
-#include "traccc/clusterization/measurement_creation.hpp"
+#include "traccc/clusterization/clusterization_config.hpp"
+#include "traccc/clusterization/fused_clusterization.hpp"
 #include "traccc/edm/cell.hpp"
 #include "traccc/edm/measurement.hpp"
+#include "traccc/geometry/geometry.hpp"
+#include "traccc/geometry/region_of_interest.hpp"
 #include "traccc/utils/algorithm.hpp"
 
 // VecMem include(s).
@@ -19,13 +21,16 @@
 
 // System include(s).
 #include <functional>
+#include <vector>
 
 namespace traccc {
 
 /// Clusterization algorithm, creating measurements from cells
 ///
 /// This algorithm creates local/2D measurements separately for each detector
-/// module from the cells of the modules.
+/// module from the cells of the modules. The cells are fed into the
+/// measurements directly, without creating an intermediate cluster
+/// container.
 ///
 class clusterization_algorithm
     : public algorithm<measurement_container_types::host(
@@ -35,8 +40,10 @@ class clusterization_algorithm
     /// Clusterization algorithm constructor
     ///
     /// @param mr The memory resource to use for the result objects
+    /// @param config The configuration of the clusterization
     ///
-    clusterization_algorithm(vecmem::memory_resource& mr);
+    clusterization_algorithm(vecmem::memory_resource& mr,
+                             const clusterization_config& config = {});
 
     /// Construct measurements for each detector module
     ///
@@ -46,15 +53,29 @@ class clusterization_algorithm
     output_type operator()(
         const cell_container_types::host& cells) const override;
 
+    /// Construct measurements for the detector modules in regions of interest
+    ///
+    /// Only the modules that have cells overlapping with at least one of the
+    /// regions of interest are processed. A module is located using the
+    /// (eta, phi) bounding box of the corners of the area spanned by its
+    /// cells, placed with the module's transform from @c geom. Modules
+    /// unknown to @c geom are skipped.
+    ///
+    /// @param cells The cells for every detector module in the event
+    /// @param geom The placements of the detector modules
+    /// @param rois The regions of interest
+    /// @return The measurements reconstructed for the selected modules
+    ///
+    output_type operator()(const cell_container_types::host& cells,
+                           const geometry& geom,
+                           const std::vector<region_of_interest>& rois) const;
+
     private:
     /// @name Sub-algorithms used by this algorithm
     /// @{
 
-    /// Per-module cluster creation algorithm
-    component_connection m_cc;
-
-    /// Per-module measurement creation algorithm
-    measurement_creation m_mc;
+    /// Per-module (fused) cluster and measurement creation algorithm
+    fused_clusterization m_fc;
 
     /// @}
 
@@ -0,0 +1,49 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2022 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+#pragma once
+
+namespace traccc {
+
+/// CCL engines for the modules not labelled with the dense CCL engine
+enum class ccl_engine {
+    /// SparseCCL, comparing every cell with the cells of the previous column
+    sparse,
+    /// Run-length CCL, comparing runs of cells in neighbouring columns
+    run_length,
+    /// Hash-based CCL, looking up the neighbours of every cell in a hash
+    /// table. The only engine that does not need the cells to be sorted.
+    hash
+};
+
+/// Configuration of the host clusterization algorithms
+struct clusterization_config {
+    /// Number of threads to process the detector modules with, the calling
+    /// thread included. With more than one thread the memory resource given
+    /// to the algorithms must be thread safe.
+    unsigned int n_threads = 1;
+    /// Minimal fraction of the pixels in the bounding box of the cells of a
+    /// module that have to be hit, for the module to be labelled with the
+    /// dense CCL engine. Values above 1 disable the dense engine.
+    float dense_ccl_min_density = 0.05f;
+    /// Minimal number of cells in a module for the dense CCL engine to be
+    /// considered. Smaller modules are always labelled with
+    /// @c sparse_engine.
+    unsigned int dense_ccl_min_cells = 64;
+    /// The engine labelling the modules not handled by the dense engine
+    ccl_engine sparse_engine = ccl_engine::sparse;
+    /// Minimal number of cells in a module for it to be split into strips of
+    /// columns, labelled on all threads at the same time. Only used with
+    /// more than one thread, and with an engine that needs sorted cells.
+    unsigned int parallel_ccl_min_cells = 4096;
+    /// Whether @c traccc::cell_filtering removes the cells with a signal not
+    /// above the threshold of their module, in addition to the masked ones.
+    /// Note that this can split clusters, see @c traccc::cell_filtering.
+    bool filter_below_threshold = true;
+};
+
+}  // namespace traccc
@@ -8,6 +8,7 @@
 #pragma once
 
 // Library include(s).
+#include "traccc/clusterization/clusterization_config.hpp"
 #include "traccc/edm/cell.hpp"
 #include "traccc/edm/cluster.hpp"
 #include "traccc/utils/algorithm.hpp"
@@ -30,6 +31,10 @@ namespace traccc {
 /// the host- and device versions of the EDM, making use of a single
 /// implementation internally.
 ///
+/// The modules can be processed on multiple threads. The modules are
+/// scheduled largest-first on a work-stealing thread pool, while the output
+/// is laid out exactly as in the single-threaded case.
+///
 class component_connection : public algorithm<cluster_container_types::host(
                                  const cell_container_types::host&)> {
 
@@ -37,7 +42,10 @@ class component_connection : public algorithm<cluster_container_types::host(
     /// Constructor for component_connection
     ///
     /// @param mr is the memory resource
-    component_connection(vecmem::memory_resource& mr) : m_mr(mr) {}
+    /// @param config is the clusterization configuration
+    component_connection(vecmem::memory_resource& mr,
+                         const clusterization_config& config = {})
+        : m_mr(mr), m_config(config) {}
 
     /// @name Operator(s) to use in host code
     /// @{
@@ -55,11 +63,24 @@ class component_connection : public algorithm<cluster_container_types::host(
     output_type operator()(
         const cell_container_types::host& cells) const override;
 
+    /// Find the clusters, describing them by the indices of their cells
+    ///
+    /// Finds the same clusters (in the same order) as the callable operator,
+    /// but instead of copying the cells, only stores their indices.
+    ///
+    /// @param cells are the input cells into the connected component
+    /// @return the clusters, referring to the cells of @c cells
+    ///
+    cluster_index_types::host cluster_indices(
+        const cell_container_types::host& cells) const;
+
     /// @}
 
     private:
     /// The memory resource used by the algorithm
     std::reference_wrapper<vecmem::memory_resource> m_mr;
+    /// The clusterization configuration
+    clusterization_config m_config;
 
 };  // class component_connection
 
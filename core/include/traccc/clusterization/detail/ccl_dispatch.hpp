@@ -0,0 +1,152 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2022 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+#pragma once
+
+// Library include(s).
+#include "traccc/clusterization/clusterization_config.hpp"
+#include "traccc/clusterization/detail/dense_ccl.hpp"
+#include "traccc/clusterization/detail/hash_ccl.hpp"
+#include "traccc/clusterization/detail/linear_ccl.hpp"
+#include "traccc/clusterization/detail/run_length_ccl.hpp"
+#include "traccc/clusterization/detail/sparse_ccl.hpp"
+#include "traccc/edm/cell.hpp"
+
+// System include(s).
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace traccc::detail {
+
+/// Scratch memory used by @c traccc::detail::run_ccl
+///
+/// It is meant to be re-used for all the modules processed by one thread,
+/// to avoid allocating new memory for every module.
+///
+struct ccl_scratch {
+    /// Image used by the dense CCL engine
+    std::vector<unsigned int> image;
+    /// Scratch memory of the run-length CCL engine
+    run_length_ccl_scratch run_length;
+    /// Scratch memory of the hash-based CCL engine
+    hash_ccl_scratch hash;
+    /// Scratch memory of the CCL engine of one-dimensional modules
+    linear_ccl_scratch linear;
+};
+
+/// Run the configured sparse CCL engine on the cells of one module
+///
+/// @param cells is the cell collection, sorted in column major unless the
+///              hash-based engine is configured
+/// @param L is the vector of the output indices (to which cluster a cell
+/// belongs to)
+/// @param config is the clusterization configuration
+/// @param scratch is the scratch memory of the calling thread
+/// @return number of clusters
+template <typename cell_container_t, typename ccl_vector_t>
+inline unsigned int run_sparse_ccl(const cell_container_t& cells,
+                                   ccl_vector_t& L,
+                                   const clusterization_config& config,
+                                   ccl_scratch& scratch) {
+
+    switch (config.sparse_engine) {
+        case ccl_engine::run_length:
+            return run_length_ccl(cells, L, scratch.run_length);
+        case ccl_engine::hash:
+            return hash_ccl(cells, L, scratch.hash);
+        case ccl_engine::sparse:
+        default:
+            return sparse_ccl(cells, L);
+    }
+}
+
+/// Run the CCL engine best suited for the cells of one module
+///
+/// Modules in which a large enough fraction of the bounding box of the cells
+/// is hit are labelled with @c traccc::detail::dense_ccl, all others with
+/// the engine selected by @c traccc::clusterization_config::sparse_engine.
+/// All engines produce exactly the same labels. The dense engine does not
+/// need sorted cells either, so with the hash-based engine configured the
+/// cells may come in any order.
+///
+/// @param cells is the cell collection, sorted in column major unless the
+///              hash-based engine is configured
+/// @param L is the vector of the output indices (to which cluster a cell
+/// belongs to)
+/// @param config is the clusterization configuration
+/// @param scratch is the scratch memory of the calling thread
+/// @return number of clusters
+template <typename cell_container_t, typename ccl_vector_t>
+inline unsigned int run_ccl(const cell_container_t& cells, ccl_vector_t& L,
+                            const clusterization_config& config,
+                            ccl_scratch& scratch) {
+
+    // The number of cells.
+    const std::size_t n_cells = cells.size();
+    if ((n_cells == 0) || (n_cells < config.dense_ccl_min_cells)) {
+        return run_sparse_ccl(cells, L, config, scratch);
+    }
+
+    // Find the bounding box of the cells. The range recorded in the module
+    // header is not used, as not all sources of cells fill it. Since the
+    // cells may not be sorted, the channel1 range is not taken from the
+    // first and last cells either.
+    channel_id min0 = cells.front().channel0, max0 = min0;
+    channel_id min1 = cells.front().channel1, max1 = min1;
+    for (const traccc::cell& c : cells) {
+        min0 = std::min(min0, c.channel0);
+        max0 = std::max(max0, c.channel0);
+        min1 = std::min(min1, c.channel1);
+        max1 = std::max(max1, c.channel1);
+    }
+    const channel_id width0 = max0 - min0 + 1;
+    const channel_id height1 = max1 - min1 + 1;
+    const std::size_t area = static_cast<std::size_t>(width0) * height1;
+
+    // Use the sparse engine for sparsely populated modules.
+    if (static_cast<float>(n_cells) <
+        config.dense_ccl_min_density * static_cast<float>(area)) {
+        return run_sparse_ccl(cells, L, config, scratch);
+    }
+
+    // Use the dense engine otherwise.
+    if (scratch.image.size() < area) {
+        scratch.image.resize(area, dense_ccl_empty_pixel);
+    }
+    return dense_ccl(cells, min0, min1, width0, height1, L, scratch.image);
+}
+
+/// Run the CCL engine best suited for the cells of one module
+///
+/// One-dimensional (strip) modules are labelled with
+/// @c traccc::detail::linear_ccl, all other modules as described for the
+/// overload without the module header. One-dimensional modules with cells
+/// in more than one channel1 column (which should not happen, but is not
+/// guaranteed by the input formats) are treated like all other modules.
+///
+/// @param module is the header of the module
+/// @param cells is the cell collection, sorted in column major unless the
+///              hash-based engine is configured
+/// @param L is the vector of the output indices (to which cluster a cell
+/// belongs to)
+/// @param config is the clusterization configuration
+/// @param scratch is the scratch memory of the calling thread
+/// @return number of clusters
+template <typename cell_container_t, typename ccl_vector_t>
+inline unsigned int run_ccl(const cell_module& module,
+                            const cell_container_t& cells, ccl_vector_t& L,
+                            const clusterization_config& config,
+                            ccl_scratch& scratch) {
+
+    if ((module.pixel.dimension == 1) && is_single_column(cells)) {
+        return linear_ccl(cells, L, scratch.linear);
+    }
+    return run_ccl(cells, L, config, scratch);
+}
+
+}  // namespace traccc::detail
@@ -0,0 +1,118 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2022 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+#pragma once
+
+// Library include(s).
+#include "traccc/clusterization/detail/sparse_ccl.hpp"
+#include "traccc/definitions/qualifiers.hpp"
+#include "traccc/edm/cell.hpp"
+
+// System include(s).
+#include <cassert>
+#include <cstddef>
+
+namespace traccc {
+
+/// Implementation of a two-pass raster scan CCL, working on an image of the
+/// bounding box of the cells of a module
+///
+/// Produces exactly the same labels as @c traccc::detail::sparse_ccl for
+/// cells sorted in column major, but does not need the cells to be sorted.
+/// (Clusters are numbered in the order of their first cell.) Its run time
+/// does not depend on how many cells there are in neighbouring columns,
+/// which makes it the better choice for densely populated modules.
+namespace detail {
+
+/// Value of the empty pixels of the images used by @c dense_ccl
+constexpr unsigned int dense_ccl_empty_pixel = static_cast<unsigned int>(-1);
+
+/// Dense CCL algorithm
+///
+/// The image has to hold at least @c width0 * @c height1 pixels, all of them
+/// set to @c dense_ccl_empty_pixel. The image is left in the same state when
+/// the function returns, so it can be re-used for the next module without
+/// having to clear it.
+///
+/// @param cells is the cell collection
+/// @param min0 is the smallest channel0 value of the cells
+/// @param min1 is the smallest channel1 value of the cells
+/// @param width0 is the number of channel0 values covered by the cells
+/// @param height1 is the number of channel1 values covered by the cells
+/// @param L is the vector of the output indices (to which cluster a cell
+/// belongs to)
+/// @param image is the scratch image to rasterize the cells into
+/// @return number of clusters
+template <typename cell_container_t, typename ccl_vector_t, typename image_t>
+TRACCC_HOST_DEVICE inline unsigned int dense_ccl(
+    const cell_container_t& cells, channel_id min0, channel_id min1,
+    channel_id width0, channel_id height1, ccl_vector_t& L, image_t& image) {
+
+    // The number of cells.
+    const unsigned int n_cells = cells.size();
+
+    // Helper function for getting the pixel of a cell.
+    auto pixel = [&](const traccc::cell& c) -> std::size_t {
+        assert(c.channel0 >= min0 && c.channel0 - min0 < width0);
+        assert(c.channel1 >= min1 && c.channel1 - min1 < height1);
+        return static_cast<std::size_t>(c.channel1 - min1) * width0 +
+               (c.channel0 - min0);
+    };
+
+    // first pass: rasterization, merging cells on the same pixel
+    for (unsigned int i = 0; i < n_cells; ++i) {
+        L[i] = i;
+        const std::size_t p = pixel(cells[i]);
+        assert(p < image.size());
+        if (image[p] == dense_ccl_empty_pixel) {
+            image[p] = i;
+        } else {
+            make_union(L, find_root(L, i), find_root(L, image[p]));
+        }
+    }
+
+    // second pass: pixel association, looking at the neighbours on the
+    // previous row and in the previous column
+    for (unsigned int i = 0; i < n_cells; ++i) {
+        const channel_id c0 = cells[i].channel0 - min0;
+        const channel_id c1 = cells[i].channel1 - min1;
+        const std::size_t p = pixel(cells[i]);
+
+        // Helper function for connecting the cell to a neighbouring pixel.
+        auto connect = [&](std::size_t q) {
+            if (image[q] != dense_ccl_empty_pixel) {
+                make_union(L, find_root(L, i), find_root(L, image[q]));
+            }
+        };
+
+        if (c0 > 0) {
+            connect(p - 1);
+        }
+        if (c1 > 0) {
+            const std::size_t q = p - width0;
+            connect(q);
+            if (c0 > 0) {
+                connect(q - 1);
+            }
+            if (c0 + 1 < width0) {
+                connect(q + 1);
+            }
+        }
+    }
+
+    // Clear the image for the next module
+    for (unsigned int i = 0; i < n_cells; ++i) {
+        image[pixel(cells[i])] = dense_ccl_empty_pixel;
+    }
+
+    // third pass: transitive closure
+    return transitive_closure(L, n_cells);
+}
+
+}  // namespace detail
+
+}  // namespace traccc
@@ -0,0 +1,140 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2022 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+#pragma once
+
+// Library include(s).
+#include "traccc/clusterization/detail/sparse_ccl.hpp"
+#include "traccc/clusterization/detail/union_find.hpp"
+#include "traccc/edm/cell.hpp"
+
+// System include(s).
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace traccc::detail {
+
+/// Value of the empty slots of the hash table of @c hash_ccl
+constexpr unsigned int hash_ccl_empty_slot = static_cast<unsigned int>(-1);
+
+/// Slot of the hash table of @c hash_ccl
+struct hash_ccl_slot {
+    /// The (channel0, channel1) position of the cell, packed into one word
+    std::uint64_t key;
+    /// Index of the cell, or @c hash_ccl_empty_slot
+    unsigned int cell;
+};
+
+/// Scratch memory used by @c traccc::detail::hash_ccl
+struct hash_ccl_scratch {
+    /// Open addressing hash table
+    std::vector<hash_ccl_slot> table;
+};
+
+/// Hash-based CCL algorithm
+///
+/// Puts the cells into an open addressing (linear probing) hash table,
+/// keyed by their (channel0, channel1) position, and looks up the
+/// neighbouring positions of every cell in it. The neighbouring cells are
+/// merged with a union-find on the output vector, using path halving, and
+/// always making the root with the smaller index the root of the merged
+/// set. So the labels can be assigned with
+/// @c traccc::detail::transitive_closure in the end.
+///
+/// Unlike @c traccc::detail::sparse_ccl, this algorithm does not need the
+/// cells to be sorted in any way. The clusters are numbered in the order of
+/// their first cell, so for cells sorted in column major it produces exactly
+/// the same labels as @c traccc::detail::sparse_ccl.
+///
+/// @param cells is the cell collection
+/// @param L is the vector of the output indices (to which cluster a cell
+/// belongs to)
+/// @param scratch is the scratch memory to use
+/// @return number of clusters
+template <typename cell_container_t, typename ccl_vector_t>
+inline unsigned int hash_ccl(const cell_container_t& cells, ccl_vector_t& L,
+                             hash_ccl_scratch& scratch) {
+
+    // The number of cells.
+    const unsigned int n_cells = cells.size();
+
+    // Set up a table with a load factor of at most 1/2. Its size is a power
+    // of two, so that the slot of a hash can be found with a shift.
+    unsigned int table_bits = 1;
+    while ((std::size_t{1} << table_bits) < 2 * std::size_t{n_cells}) {
+        ++table_bits;
+    }
+    const std::size_t table_mask = (std::size_t{1} << table_bits) - 1;
+    scratch.table.assign(table_mask + 1, {0, hash_ccl_empty_slot});
+
+    // Helper function for packing a position into a key.
+    auto make_key = [](channel_id ch0, channel_id ch1) -> std::uint64_t {
+        return (static_cast<std::uint64_t>(ch0) << 32) | ch1;
+    };
+
+    // Helper function for finding the slot of a key, among the cells already
+    // in the table. This is either the slot holding a cell with that key, or
+    // the empty slot where such a cell would be added. The probing starts at
+    // the slot given by the Fibonacci hash of the key.
+    auto find_slot = [&](std::uint64_t key) -> hash_ccl_slot& {
+        std::size_t s = static_cast<std::size_t>(
+            (key * 0x9E3779B97F4A7C15ull) >> (64 - table_bits));
+        while ((scratch.table[s].cell != hash_ccl_empty_slot) &&
+               (scratch.table[s].key != key)) {
+            s = (s + 1) & table_mask;
+        }
+        return scratch.table[s];
+    };
+
+    // first scan: add the cells to the table, merging the cells that are on
+    // the same position
+    for (unsigned int i = 0; i < n_cells; ++i) {
+        L[i] = i;
+        const std::uint64_t key =
+            make_key(cells[i].channel0, cells[i].channel1);
+        hash_ccl_slot& own_slot = find_slot(key);
+        if (own_slot.cell == hash_ccl_empty_slot) {
+            own_slot = {key, i};
+        } else {
+            make_union(L, own_slot.cell, i);
+        }
+    }
+
+    // second scan: merge every cell with its neighbours. Since adjacency is
+    // symmetric, only the 4 neighbours with a larger channel1, or the same
+    // channel1 and a larger channel0 need to be looked up.
+    for (unsigned int i = 0; i < n_cells; ++i) {
+        const channel_id ch0 = cells[i].channel0;
+        const channel_id ch1 = cells[i].channel1;
+
+        // Helper function for merging the cell with a neighbouring position,
+        // keeping track of the root of the cell's set.
+        unsigned int root = union_find_root(L, i);
+        auto connect = [&](channel_id n0, channel_id n1) {
+            const unsigned int j = find_slot(make_key(n0, n1)).cell;
+            if (j != hash_ccl_empty_slot) {
+                const unsigned int root_j = union_find_root(L, j);
+                if (root_j != root) {
+                    root = make_union(L, root, root_j);
+                }
+            }
+        };
+
+        connect(ch0 + 1, ch1);
+        if (ch0 > 0) {
+            connect(ch0 - 1, ch1 + 1);
+        }
+        connect(ch0, ch1 + 1);
+        connect(ch0 + 1, ch1 + 1);
+    }
+
+    // third scan: transitive closure
+    return transitive_closure(L, n_cells);
+}
+
+}  // namespace traccc::detail
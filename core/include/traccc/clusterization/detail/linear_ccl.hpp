@@ -0,0 +1,117 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2022 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+#pragma once
+
+// Library include(s).
+#include "traccc/edm/cell.hpp"
+
+// System include(s).
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+#include <vector>
+
+namespace traccc::detail {
+
+/// Scratch memory used by @c traccc::detail::linear_ccl
+struct linear_ccl_scratch {
+    /// Cell indices, ordered by channel0
+    std::vector<unsigned int> order;
+    /// Final label of every run of cells
+    std::vector<unsigned int> run_labels;
+};
+
+/// Check if all cells of a module are in the same channel1 column
+///
+/// @param cells is the cell collection
+/// @return @c true if the cells can be labelled with @c linear_ccl
+template <typename cell_container_t>
+inline bool is_single_column(const cell_container_t& cells) {
+
+    return std::all_of(cells.begin(), cells.end(),
+                       [&cells](const traccc::cell& c) {
+                           return c.channel1 == cells.front().channel1;
+                       });
+}
+
+/// CCL algorithm for the cells of one-dimensional (strip) modules
+///
+/// All cells of the module have to be in the same channel1 column, which
+/// the caller has to make sure of with @c is_single_column. Two
+/// cells are then neighbours if their channel0 values differ by at most
+/// one, so the clusters are just the runs of consecutive channel0 values,
+/// found in a single pass over the cells ordered by channel0. (The cells
+/// are ordered first if they are not already.) The clusters are numbered
+/// in the order of their first cell, so this produces exactly the same
+/// labels as @c traccc::detail::sparse_ccl.
+///
+/// @param cells is the cell collection
+/// @param L is the vector of the output indices (to which cluster a cell
+/// belongs to)
+/// @param scratch is the scratch memory to use
+/// @return number of clusters
+template <typename cell_container_t, typename ccl_vector_t>
+inline unsigned int linear_ccl(const cell_container_t& cells, ccl_vector_t& L,
+                               linear_ccl_scratch& scratch) {
+
+    // The number of cells.
+    const unsigned int n_cells = cells.size();
+    if (n_cells == 0) {
+        return 0;
+    }
+
+    // Order the cells by channel0, if they are not already.
+    bool sorted = true;
+    for (unsigned int i = 1; i < n_cells; ++i) {
+        assert(cells[i].channel1 == cells[0].channel1);
+        sorted = sorted && (cells[i - 1].channel0 <= cells[i].channel0);
+    }
+    if (sorted) {
+        unsigned int labels = 1;
+        L[0] = labels;
+        for (unsigned int i = 1; i < n_cells; ++i) {
+            if (cells[i].channel0 > cells[i - 1].channel0 + 1) {
+                ++labels;
+            }
+            L[i] = labels;
+        }
+        return labels;
+    }
+    auto& order = scratch.order;
+    order.resize(n_cells);
+    std::iota(order.begin(), order.end(), 0u);
+    std::sort(order.begin(), order.end(),
+              [&cells](unsigned int a, unsigned int b) {
+                  return cells[a].channel0 < cells[b].channel0;
+              });
+
+    // Number the runs of consecutive channel0 values.
+    unsigned int n_runs = 1;
+    L[order[0]] = n_runs;
+    for (unsigned int k = 1; k < n_cells; ++k) {
+        if (cells[order[k]].channel0 > cells[order[k - 1]].channel0 + 1) {
+            ++n_runs;
+        }
+        L[order[k]] = n_runs;
+    }
+
+    // Re-number the runs in the order of their first cell.
+    scratch.run_labels.assign(n_runs, 0);
+    unsigned int labels = 0;
+    for (unsigned int i = 0; i < n_cells; ++i) {
+        unsigned int& label = scratch.run_labels[L[i] - 1];
+        if (label == 0) {
+            label = ++labels;
+        }
+        L[i] = label;
+    }
+
+    return labels;
+}
+
+}  // namespace traccc::detail
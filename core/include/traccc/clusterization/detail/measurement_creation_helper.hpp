@@ -14,6 +14,9 @@
 #include "traccc/edm/cluster.hpp"
 #include "traccc/edm/measurement.hpp"
 
+// System include(s).
+#include <cassert>
+
 namespace traccc::detail {
 
 /// Function used for retrieving the cell signal based on the module id
@@ -31,9 +34,52 @@ inline vector2 position_from_cell(const cell& c, const cell_module& module) {
             module.pixel.min_center_y + c.channel1 * module.pixel.pitch_y};
 }
 
+/// Function used for adding a single cell to the properties of a cluster
+/// during measurement creation
+///
+/// @param[in] cell    The cell to add to the cluster
+/// @param[in] module  The cell module
+/// @param[inout] mean The mean position of the cluster/measurement
+/// @param[inout] var  The variation on the mean position of the
+///                    cluster/measurement
+/// @param[inout] totalWeight The total weight of the cluster/measurement
+///
+TRACCC_HOST_DEVICE inline void update_cluster_properties(
+    const cell& cell, const cell_module& module, point2& mean, point2& var,
+    scalar& totalWeight) {
+
+    // Translate the cell readout value into a weight.
+    const scalar weight = signal_cell_modelling(cell.activation, module);
+
+    // Only consider cells over a minimum threshold.
+    if (weight > module.threshold) {
+
+        // Update all output properties with this cell.
+        totalWeight += cell.activation;
+        const point2 cell_position = position_from_cell(cell, module);
+        const point2 prev = mean;
+        const point2 diff = cell_position - prev;
+
+        mean = prev + (weight / totalWeight) * diff;
+        for (std::size_t i = 0; i < 2; ++i) {
+            var[i] = var[i] + weight * (diff[i]) * (cell_position[i] - mean[i]);
+        }
+    }
+}
+
 /// Function used for calculating the properties of the cluster during
 /// measurement creation
 ///
+/// To calculate the mean and variance with high numerical stability a
+/// weighted variant of Welford's algorithm is used. This is a single-pass
+/// online algorithm that works well for large numbers of samples, as well
+/// as samples with very high values.
+///
+/// To learn more about this algorithm please refer to:
+/// [1] https://doi.org/10.1080/00401706.1962.10490022
+/// [2] The Art of Computer Programming, Donald E. Knuth, second
+///     edition, chapter 4.2.2.
+///
 /// @param[in] cluster The vector of cells describing the identified cluster
 /// @param[in] module  The cell module
 /// @param[out] mean   The mean position of the cluster/measurement
@@ -48,26 +94,202 @@ TRACCC_HOST_DEVICE inline void calc_cluster_properties(
 
     // Loop over the cells of the cluster.
     for (const cell& cell : cluster) {
+        update_cluster_properties(cell, module, mean, var, totalWeight);
+    }
+}
 
-        // Translate the cell readout value into a weight.
-        const scalar weight = signal_cell_modelling(cell.activation, module);
+/// Largest cluster size handled by @c calc_small_cluster_properties
+constexpr unsigned int small_cluster_size = 4;
 
+/// Function calculating the properties of a single cell cluster
+///
+/// Gives the same result as @c calc_cluster_properties, without any of the
+/// arithmetic of the general case.
+///
+/// @param[in] cell    The cell of the cluster
+/// @param[in] module  The cell module
+/// @param[out] mean   The mean position of the cluster/measurement
+/// @param[out] var    The variation on the mean position of the
+///                    cluster/measurement
+/// @param[out] totalWeight The total weight of the cluster/measurement
+///
+TRACCC_HOST_DEVICE inline void calc_single_cell_cluster_properties(
+    const cell& cell, const cell_module& module, point2& mean, point2& var,
+    scalar& totalWeight) {
+
+    // Only consider cells over a minimum threshold.
+    if (signal_cell_modelling(cell.activation, module) > module.threshold) {
+        totalWeight = cell.activation;
+        mean = position_from_cell(cell, module);
+        var = {0., 0.};
+    }
+}
+
+/// Function calculating the properties of a two cell cluster
+///
+/// Performs the same operations as the second step of
+/// @c calc_cluster_properties, knowing that the first step just copies
+/// the position of the first cell. So it gives bit-identical results.
+///
+/// @param[in] cell1   The first cell of the cluster
+/// @param[in] cell2   The second cell of the cluster
+/// @param[in] module  The cell module
+/// @param[out] mean   The mean position of the cluster/measurement
+/// @param[out] var    The variation on the mean position of the
+///                    cluster/measurement
+/// @param[out] totalWeight The total weight of the cluster/measurement
+///
+TRACCC_HOST_DEVICE inline void calc_two_cell_cluster_properties(
+    const cell& cell1, const cell& cell2, const cell_module& module,
+    point2& mean, point2& var, scalar& totalWeight) {
+
+    // Check which cells are over the threshold.
+    const bool pass1 =
+        (signal_cell_modelling(cell1.activation, module) > module.threshold);
+    const scalar weight2 = signal_cell_modelling(cell2.activation, module);
+    const bool pass2 = (weight2 > module.threshold);
+
+    if (pass1 && pass2) {
+        totalWeight = cell1.activation + cell2.activation;
+        const point2 position1 = position_from_cell(cell1, module);
+        const point2 position2 = position_from_cell(cell2, module);
+        const point2 diff = position2 - position1;
+
+        mean = position1 + (weight2 / totalWeight) * diff;
+        for (std::size_t i = 0; i < 2; ++i) {
+            var[i] = weight2 * (diff[i]) * (position2[i] - mean[i]);
+        }
+    } else if (pass1) {
+        calc_single_cell_cluster_properties(cell1, module, mean, var,
+                                            totalWeight);
+    } else if (pass2) {
+        calc_single_cell_cluster_properties(cell2, module, mean, var,
+                                            totalWeight);
+    }
+}
+
+/// Function calculating the properties of a small cluster
+///
+/// Uses a two-pass algorithm (with a single division), on the positions
+/// of the cells relative to the first cell of the cluster. This keeps the
+/// result within floating point precision of @c calc_cluster_properties.
+///
+/// @param[in] cluster The vector of cells describing the identified cluster,
+///                    with at most @c small_cluster_size cells
+/// @param[in] module  The cell module
+/// @param[out] mean   The mean position of the cluster/measurement
+/// @param[out] var    The variation on the mean position of the
+///                    cluster/measurement
+/// @param[out] totalWeight The total weight of the cluster/measurement
+///
+template <typename cell_collection_t>
+TRACCC_HOST_DEVICE inline void calc_small_cluster_properties(
+    const cell_collection_t& cluster, const cell_module& module, point2& mean,
+    point2& var, scalar& totalWeight) {
+
+    const unsigned int n_cells = cluster.size();
+    assert(n_cells <= small_cluster_size);
+
+    // First pass: collect the weights and the weighted sum of the positions.
+    const point2 origin = position_from_cell(cluster[0], module);
+    scalar weights[small_cluster_size];
+    point2 offsets[small_cluster_size];
+    point2 sum{0., 0.};
+    totalWeight = 0.;
+    for (unsigned int i = 0; i < n_cells; ++i) {
         // Only consider cells over a minimum threshold.
-        if (weight > module.threshold) {
-
-            // Update all output properties with this cell.
-            totalWeight += cell.activation;
-            const point2 cell_position = position_from_cell(cell, module);
-            const point2 prev = mean;
-            const point2 diff = cell_position - prev;
-
-            mean = prev + (weight / totalWeight) * diff;
-            for (std::size_t i = 0; i < 2; ++i) {
-                var[i] =
-                    var[i] + weight * (diff[i]) * (cell_position[i] - mean[i]);
-            }
+        weights[i] = signal_cell_modelling(cluster[i].activation, module);
+        if (weights[i] > module.threshold) {
+            totalWeight += cluster[i].activation;
+        } else {
+            weights[i] = 0.;
+        }
+        offsets[i] = position_from_cell(cluster[i], module) - origin;
+        for (std::size_t j = 0; j < 2; ++j) {
+            sum[j] += weights[i] * offsets[i][j];
+        }
+    }
+    if (!(totalWeight > 0.)) {
+        return;
+    }
+
+    // Second pass: calculate the variance around the mean.
+    const point2 offset_mean{sum[0] / totalWeight, sum[1] / totalWeight};
+    var = {0., 0.};
+    for (unsigned int i = 0; i < n_cells; ++i) {
+        for (std::size_t j = 0; j < 2; ++j) {
+            const scalar diff = offsets[i][j] - offset_mean[j];
+            var[j] += weights[i] * diff * diff;
         }
     }
+    mean = origin + offset_mean;
+}
+
+/// Function creating a measurement out of the properties of a cluster
+///
+/// @param[in] mean        The mean position of the cluster
+/// @param[in] var         The (not yet normalized) variation on the mean
+///                        position of the cluster
+/// @param[in] totalWeight The total weight of the cluster, must be positive
+/// @param[in] module      The cell module where the cluster belongs to
+/// @param[in] cl_link     The cluster index of the cluster container
+///
+/// @return The measurement describing the cluster
+///
+TRACCC_HOST_DEVICE inline measurement create_measurement(
+    const point2& mean, const point2& var, const scalar totalWeight,
+    const cell_module& module, const std::size_t cl_link) {
+
+    measurement m;
+    // cluster link
+    m.cluster_link = cl_link;
+    // normalize the cell position
+    m.local = mean;
+    // normalize the variance
+    m.variance[0] = var[0] / totalWeight;
+    m.variance[1] = var[1] / totalWeight;
+    // plus pitch^2 / 12
+    const auto pitch = module.pixel.get_pitch();
+    m.variance = m.variance +
+                 point2{pitch[0] * pitch[0] / 12, pitch[1] * pitch[1] / 12};
+    // @todo add variance estimation
+
+    return m;
+}
+
+/// Function calculating the properties of a cluster of any size
+///
+/// Selects the fastest of the functions above that is suitable for the
+/// size of the cluster.
+///
+/// @param[in] cluster     The vector of cells describing the identified
+///                        cluster
+/// @param[in] module      The cell module
+/// @param[out] mean       The mean position of the cluster/measurement
+/// @param[out] var        The variation on the mean position of the
+///                        cluster/measurement
+/// @param[out] totalWeight The total weight of the cluster/measurement
+///
+template <typename cell_collection_t>
+TRACCC_HOST_DEVICE inline void calc_measurement_properties(
+    const cell_collection_t& cluster, const cell_module& module, point2& mean,
+    point2& var, scalar& totalWeight) {
+
+    // Use a fast path for the most common cluster sizes
+    const unsigned int n_cells = cluster.size();
+    if (n_cells == 1) {
+        detail::calc_single_cell_cluster_properties(cluster[0], module, mean,
+                                                    var, totalWeight);
+    } else if (n_cells == 2) {
+        detail::calc_two_cell_cluster_properties(cluster[0], cluster[1], module,
+                                                 mean, var, totalWeight);
+    } else if (n_cells <= small_cluster_size) {
+        detail::calc_small_cluster_properties(cluster, module, mean, var,
+                                              totalWeight);
+    } else {
+        detail::calc_cluster_properties(cluster, module, mean, var,
+                                        totalWeight);
+    }
 }
 
 /// Function used for calculating the properties of the cluster during
@@ -86,38 +308,17 @@ TRACCC_HOST_DEVICE inline void fill_measurement(
     const cell_module& module, const std::size_t module_link,
     const std::size_t cl_link) {
 
-    // To calculate the mean and variance with high numerical stability
-    // we use a weighted variant of Welford's algorithm. This is a
-    // single-pass online algorithm that works well for large numbers
-    // of samples, as well as samples with very high values.
-    //
-    // To learn more about this algorithm please refer to:
-    // [1] https://doi.org/10.1080/00401706.1962.10490022
-    // [2] The Art of Computer Programming, Donald E. Knuth, second
-    //     edition, chapter 4.2.2.
-
-    // Calculate the cluster properties
+    // Calculate the cluster properties, with the function best suited for
+    // the size of the cluster. (The general case uses a weighted variant of
+    // Welford's algorithm, see calc_cluster_properties.)
     scalar totalWeight = 0.;
     point2 mean{0., 0.}, var{0., 0.};
-    detail::calc_cluster_properties(cluster, module, mean, var, totalWeight);
+    calc_measurement_properties(cluster, module, mean, var, totalWeight);
 
     if (totalWeight > 0.) {
-        measurement m;
-        // cluster link
-        m.cluster_link = cl_link;
-        // normalize the cell position
-        m.local = mean;
-        // normalize the variance
-        m.variance[0] = var[0] / totalWeight;
-        m.variance[1] = var[1] / totalWeight;
-        // plus pitch^2 / 12
-        const auto pitch = module.pixel.get_pitch();
-        m.variance = m.variance +
-                     point2{pitch[0] * pitch[0] / 12, pitch[1] * pitch[1] / 12};
-        // @todo add variance estimation
-
         measurements[module_link].header = module;
-        measurements[module_link].items.push_back(std::move(m));
+        measurements[module_link].items.push_back(
+            create_measurement(mean, var, totalWeight, module, cl_link));
     }
 }
 
@@ -0,0 +1,129 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2022 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+#pragma once
+
+// Library include(s).
+#include "traccc/clusterization/clusterization_config.hpp"
+#include "traccc/clusterization/detail/ccl_dispatch.hpp"
+#include "traccc/clusterization/detail/measurement_creation_helper.hpp"
+#include "traccc/definitions/primitives.hpp"
+#include "traccc/edm/cell.hpp"
+#include "traccc/edm/cluster.hpp"
+#include "traccc/edm/measurement.hpp"
+
+// System include(s).
+#include <cstddef>
+#include <vector>
+
+namespace traccc::detail {
+
+/// Scratch memory used by @c traccc::detail::clusterize_module
+///
+/// It is meant to be re-used for all the modules processed by one thread,
+/// to avoid allocating new memory for every module.
+///
+struct module_clusterization_scratch {
+    /// Scratch memory of the CCL engines
+    ccl_scratch ccl;
+    /// Cluster label of every cell
+    std::vector<unsigned int> labels;
+    /// Offset of the cells of every cluster in @c cell_indices
+    std::vector<unsigned int> cluster_offsets;
+    /// Indices of the cells, grouped by cluster
+    std::vector<unsigned int> cell_indices;
+};
+
+/// Create the measurements of the already labelled cells of one module
+///
+/// The cells are grouped by their cluster label, as found in
+/// @c scratch.labels, keeping their order inside of every cluster. The
+/// properties of every cluster are then calculated with
+/// @c traccc::detail::calc_measurement_properties, just like in
+/// @c traccc::measurement_creation.
+///
+/// @param module is the header of the module
+/// @param cells is the cell collection
+/// @param num_clusters is the number of clusters in the module
+/// @param scratch is the scratch memory of the calling thread
+/// @param cluster_offset is added to the cluster links of the measurements
+/// @param measurements is the collection the measurements are appended to
+template <typename cell_container_t, typename measurement_container_t>
+inline void create_module_measurements(const cell_module& module,
+                                       const cell_container_t& cells,
+                                       std::size_t num_clusters,
+                                       module_clusterization_scratch& scratch,
+                                       std::size_t cluster_offset,
+                                       measurement_container_t& measurements) {
+
+    // Count the cells of every cluster, to get the offset of every cluster.
+    const unsigned int n_cells = cells.size();
+    auto& offsets = scratch.cluster_offsets;
+    offsets.assign(num_clusters + 1, 0);
+    for (unsigned int i = 0; i < n_cells; ++i) {
+        ++offsets[scratch.labels[i]];
+    }
+    for (std::size_t i = 1; i <= num_clusters; ++i) {
+        offsets[i] += offsets[i - 1];
+    }
+
+    // Group the cell indices by cluster. This moves the offset of every
+    // cluster to the end of its cells, i.e. to the offset of the next one.
+    scratch.cell_indices.resize(n_cells);
+    for (unsigned int i = 0; i < n_cells; ++i) {
+        scratch.cell_indices[offsets[scratch.labels[i] - 1]++] = i;
+    }
+
+    // Create the measurements of the module.
+    measurements.reserve(measurements.size() + num_clusters);
+    for (std::size_t i = 0; i < num_clusters; ++i) {
+        const unsigned int begin = (i == 0) ? 0 : offsets[i - 1];
+        const cluster_cells<cell_container_t, const unsigned int> cluster(
+            cells, scratch.cell_indices.data() + begin, offsets[i] - begin);
+
+        scalar totalWeight = 0.;
+        point2 mean{0., 0.}, var{0., 0.};
+        calc_measurement_properties(cluster, module, mean, var, totalWeight);
+        if (totalWeight > 0.) {
+            measurements.push_back(create_measurement(
+                mean, var, totalWeight, module, cluster_offset + i));
+        }
+    }
+}
+
+/// Create the measurements of the cells of one module
+///
+/// The cells are labelled with @c traccc::detail::run_ccl (with
+/// @c traccc::detail::linear_ccl for one-dimensional modules), and are then
+/// handed to @c traccc::detail::create_module_measurements.
+///
+/// @param module is the header of the module
+/// @param cells is the cell collection, sorted in column major
+/// @param config is the clusterization configuration
+/// @param scratch is the scratch memory of the calling thread
+/// @param cluster_offset is added to the cluster links of the measurements
+/// @param measurements is the collection the measurements are appended to
+/// @return number of clusters
+template <typename cell_container_t, typename measurement_container_t>
+inline std::size_t clusterize_module(const cell_module& module,
+                                     const cell_container_t& cells,
+                                     const clusterization_config& config,
+                                     module_clusterization_scratch& scratch,
+                                     std::size_t cluster_offset,
+                                     measurement_container_t& measurements) {
+
+    // Run SparseCCL (or the dense CCL) to label the cells
+    scratch.labels.resize(cells.size());
+    const std::size_t num_clusters =
+        run_ccl(module, cells, scratch.labels, config, scratch.ccl);
+
+    create_module_measurements(module, cells, num_clusters, scratch,
+                               cluster_offset, measurements);
+    return num_clusters;
+}
+
+}  // namespace traccc::detail
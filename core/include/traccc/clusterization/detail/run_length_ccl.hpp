@@ -0,0 +1,159 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2022 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+#pragma once
+
+// Library include(s).
+#include "traccc/clusterization/detail/union_find.hpp"
+#include "traccc/edm/cell.hpp"
+
+// System include(s).
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace traccc::detail {
+
+/// A run of cells with consecutive channel0 values, in one column
+struct cell_run {
+    /// The smallest channel0 value of the run
+    channel_id first0;
+    /// The largest channel0 value of the run
+    channel_id last0;
+};
+
+/// Scratch memory used by @c traccc::detail::run_length_ccl
+struct run_length_ccl_scratch {
+    /// Cell indices of the current column, ordered by channel0
+    std::vector<unsigned int> order;
+    /// Index of the run that every cell belongs to
+    std::vector<unsigned int> cell_runs;
+    /// The runs of all columns, one column after the other
+    std::vector<cell_run> runs;
+    /// Parent table of the run union-find
+    std::vector<unsigned int> parent;
+    /// Rank table of the run union-find
+    std::vector<unsigned char> rank;
+    /// Label given to every union-find root
+    std::vector<unsigned int> root_labels;
+};
+
+/// Run-length CCL algorithm
+///
+/// Splits every column of cells into runs of consecutive channel0 values,
+/// and only compares the runs of neighbouring columns with each other. The
+/// runs are merged with a union-find, using path compression and union by
+/// rank. Produces exactly the same labels as
+/// @c traccc::detail::sparse_ccl, so it also requires the cells to be
+/// sorted in column major. (The order of the cells inside of a column does
+/// not matter.)
+///
+/// @param cells is the cell collection
+/// @param L is the vector of the output indices (to which cluster a cell
+/// belongs to)
+/// @param scratch is the scratch memory to use
+/// @return number of clusters
+template <typename cell_container_t, typename ccl_vector_t>
+inline unsigned int run_length_ccl(const cell_container_t& cells,
+                                   ccl_vector_t& L,
+                                   run_length_ccl_scratch& scratch) {
+
+    // The number of cells.
+    const unsigned int n_cells = cells.size();
+
+    scratch.cell_runs.resize(n_cells);
+    scratch.runs.clear();
+    scratch.parent.clear();
+    scratch.rank.clear();
+
+    // first scan: build the runs of every column, and merge them with the
+    // overlapping runs of the previous column
+    std::size_t prev_begin = 0, prev_end = 0;
+    channel_id prev_column = 0;
+    for (unsigned int begin = 0; begin < n_cells;) {
+
+        // Find the cells of this column.
+        const channel_id column = cells[begin].channel1;
+        unsigned int end = begin + 1;
+        while ((end < n_cells) && (cells[end].channel1 == column)) {
+            ++end;
+        }
+
+        // Order the cells of the column by channel0, if they are not
+        // already.
+        auto& order = scratch.order;
+        order.resize(end - begin);
+        bool sorted = true;
+        for (unsigned int i = begin; i < end; ++i) {
+            order[i - begin] = i;
+            sorted = sorted && ((i == begin) || (cells[i - 1].channel0 <=
+                                                 cells[i].channel0));
+        }
+        if (!sorted) {
+            std::sort(order.begin(), order.end(),
+                      [&cells](unsigned int a, unsigned int b) {
+                          return cells[a].channel0 < cells[b].channel0;
+                      });
+        }
+
+        // Create the runs of the column.
+        const std::size_t cur_begin = scratch.runs.size();
+        for (unsigned int i : order) {
+            const channel_id ch0 = cells[i].channel0;
+            if ((scratch.runs.size() == cur_begin) ||
+                (ch0 > scratch.runs.back().last0 + 1)) {
+                scratch.runs.push_back({ch0, ch0});
+                scratch.parent.push_back(scratch.parent.size());
+                scratch.rank.push_back(0);
+            } else {
+                scratch.runs.back().last0 = ch0;
+            }
+            scratch.cell_runs[i] = scratch.runs.size() - 1;
+        }
+        const std::size_t cur_end = scratch.runs.size();
+
+        // Merge with the touching runs of the previous column. Both lists
+        // of runs are ordered by channel0, so one pass over them is enough.
+        if ((cur_begin > 0) && (prev_column + 1 == column)) {
+            std::size_t p = prev_begin, c = cur_begin;
+            while ((p < prev_end) && (c < cur_end)) {
+                const cell_run& pr = scratch.runs[p];
+                const cell_run& cr = scratch.runs[c];
+                if ((pr.first0 <= cr.last0 + 1) &&
+                    (cr.first0 <= pr.last0 + 1)) {
+                    union_find_merge(scratch.parent, scratch.rank, p, c);
+                }
+                if (pr.last0 < cr.last0) {
+                    ++p;
+                } else {
+                    ++c;
+                }
+            }
+        }
+
+        prev_begin = cur_begin;
+        prev_end = cur_end;
+        prev_column = column;
+        begin = end;
+    }
+
+    // second scan: number the clusters in the order of their first cell
+    unsigned int labels = 0;
+    scratch.root_labels.assign(scratch.runs.size(), 0);
+    for (unsigned int i = 0; i < n_cells; ++i) {
+        const unsigned int root =
+            union_find_root(scratch.parent, scratch.cell_runs[i]);
+        if (scratch.root_labels[root] == 0) {
+            scratch.root_labels[root] = ++labels;
+        }
+        L[i] = scratch.root_labels[root];
+    }
+
+    return labels;
+}
+
+}  // namespace traccc::detail
@@ -89,6 +89,35 @@ TRACCC_HOST_DEVICE inline bool is_far_enough(traccc::cell a, traccc::cell b) {
     return (a.channel1 - b.channel1) > 1;
 }
 
+/// Turn an equivalence table into cluster labels
+///
+/// Every entry of the table has to point to itself, or to an entry with a
+/// smaller index. The clusters are then numbered from 1, in the order of
+/// their first entry.
+///
+/// @param L is the equivalence table, replaced by the cluster labels
+/// @param n_cells is the number of entries in the table
+///
+/// @return number of clusters
+template <typename ccl_vector_t>
+TRACCC_HOST_DEVICE inline unsigned int transitive_closure(
+    ccl_vector_t& L, unsigned int n_cells) {
+
+    unsigned int labels = 0;
+    for (unsigned int i = 0; i < n_cells; ++i) {
+        unsigned int l = 0;
+        if (L[i] == i) {
+            ++labels;
+            l = labels;
+        } else {
+            l = L[L[i]];
+        }
+        L[i] = l;
+    }
+
+    return labels;
+}
+
 /// Sparce CCL algorithm
 ///
 /// @param cells is the cell collection
@@ -100,8 +129,6 @@ template <typename cell_container_t, typename ccl_vector_t>
 TRACCC_HOST_DEVICE inline unsigned int sparse_ccl(const cell_container_t& cells,
                                                   ccl_vector_t& L) {
 
-    unsigned int labels = 0;
-
     // The number of cells.
     const unsigned int n_cells = cells.size();
 
@@ -122,18 +149,7 @@ TRACCC_HOST_DEVICE inline unsigned int sparse_ccl(const cell_container_t& cells,
     }
 
     // second scan: transitive closure
-    for (unsigned int i = 0; i < n_cells; ++i) {
-        unsigned int l = 0;
-        if (L[i] == i) {
-            ++labels;
-            l = labels;
-        } else {
-            l = L[L[i]];
-        }
-        L[i] = l;
-    }
-
-    return labels;
+    return transitive_closure(L, n_cells);
 }
 }  // namespace detail
 
@@ -0,0 +1,202 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2022 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+#pragma once
+
+// Library include(s).
+#include "traccc/clusterization/clusterization_config.hpp"
+#include "traccc/clusterization/detail/ccl_dispatch.hpp"
+#include "traccc/clusterization/detail/sparse_ccl.hpp"
+#include "traccc/edm/cell.hpp"
+#include "traccc/utils/work_stealing.hpp"
+
+// System include(s).
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+namespace traccc::detail {
+
+/// Number of strips that @c strip_ccl splits a module into, per thread
+constexpr unsigned int strip_ccl_strips_per_thread = 4;
+
+/// View of a contiguous range of an array, as processed by @c strip_ccl
+template <typename T>
+struct array_range {
+    /// Pointer to the first element of the range
+    T* ptr;
+    /// Number of elements in the range
+    unsigned int n;
+
+    unsigned int size() const { return n; }
+    T& operator[](unsigned int i) const { return ptr[i]; }
+    T& front() const { return ptr[0]; }
+    T& back() const { return ptr[n - 1]; }
+    T* begin() const { return ptr; }
+    T* end() const { return ptr + n; }
+};
+
+/// Scratch memory used by @c traccc::detail::strip_ccl
+struct strip_ccl_scratch {
+    /// Index of the first cell of every strip, followed by the number of
+    /// cells
+    std::vector<unsigned int> strip_begin;
+    /// Number of clusters found in every strip
+    std::vector<unsigned int> strip_labels;
+    /// Index of the first label of every strip, among all labels
+    std::vector<unsigned int> label_offset;
+    /// Equivalence table of the labels of all strips
+    std::vector<unsigned int> label_parent;
+    /// Scratch memory of the CCL engines, for every thread
+    std::vector<ccl_scratch> workers;
+};
+
+/// Check if a module should be labelled with @c strip_ccl
+///
+/// One-dimensional modules are never split up, as all of their cells are in
+/// a single column.
+///
+/// @param module is the header of the module
+/// @param n_cells is the number of cells in the module
+/// @param config is the clusterization configuration
+/// @return @c true if the module is big enough to be split up
+inline bool use_strip_ccl(const cell_module& module, std::size_t n_cells,
+                          const clusterization_config& config) {
+    return (config.n_threads > 1) && (module.pixel.dimension != 1) &&
+           (config.sparse_engine != ccl_engine::hash) &&
+           (n_cells >= config.parallel_ccl_min_cells);
+}
+
+/// CCL algorithm labelling the cells of a single module on multiple threads
+///
+/// The cells are split into strips of whole columns, with roughly the same
+/// number of cells. Each strip is labelled by @c traccc::detail::run_ccl
+/// on its own, on @c clusterization_config::n_threads threads. The labels
+/// of the clusters touching across the strip boundaries are then merged in
+/// an equivalence table, which is resolved with
+/// @c traccc::detail::transitive_closure.
+///
+/// Since both the strips and the clusters inside of them are ordered by
+/// their first cell, this produces exactly the same labels as
+/// @c traccc::detail::sparse_ccl. Like that, it requires the cells to be
+/// sorted in column major. Both the cells and the labels need to be stored
+/// contiguously.
+///
+/// @param cells is the cell collection
+/// @param L is the vector of the output indices (to which cluster a cell
+/// belongs to)
+/// @param config is the clusterization configuration
+/// @param scratch is the scratch memory to use
+/// @return number of clusters
+template <typename cell_container_t, typename ccl_vector_t>
+inline unsigned int strip_ccl(const cell_container_t& cells, ccl_vector_t& L,
+                              const clusterization_config& config,
+                              strip_ccl_scratch& scratch) {
+
+    // The number of cells.
+    const unsigned int n_cells = cells.size();
+    if (n_cells == 0) {
+        return 0;
+    }
+
+    // Split the cells into strips, only ever between two columns.
+    const unsigned int n_threads = std::max(config.n_threads, 1u);
+    const unsigned int max_strips = n_threads * strip_ccl_strips_per_thread;
+    scratch.strip_begin.assign(1, 0);
+    for (unsigned int s = 1; s < max_strips; ++s) {
+        unsigned int begin = static_cast<unsigned int>(
+            static_cast<std::size_t>(n_cells) * s / max_strips);
+        begin = std::max(begin, scratch.strip_begin.back() + 1);
+        while ((begin < n_cells) &&
+               (cells[begin].channel1 == cells[begin - 1].channel1)) {
+            ++begin;
+        }
+        if (begin >= n_cells) {
+            break;
+        }
+        scratch.strip_begin.push_back(begin);
+    }
+    scratch.strip_begin.push_back(n_cells);
+    const std::size_t n_strips = scratch.strip_begin.size() - 1;
+
+    // Label the strips independently, biggest first.
+    std::vector<std::size_t> strip_sizes(n_strips);
+    for (std::size_t s = 0; s < n_strips; ++s) {
+        strip_sizes[s] = scratch.strip_begin[s + 1] - scratch.strip_begin[s];
+    }
+    scratch.strip_labels.resize(n_strips);
+    if (scratch.workers.size() < n_threads) {
+        scratch.workers.resize(n_threads);
+    }
+    work_stealing_for_each(
+        largest_first(strip_sizes), n_threads,
+        [&](std::size_t s, unsigned int worker) {
+            const unsigned int begin = scratch.strip_begin[s];
+            const unsigned int size = static_cast<unsigned int>(strip_sizes[s]);
+            const array_range<const traccc::cell> strip_cells{&(cells[begin]),
+                                                              size};
+            array_range<unsigned int> strip_labels{&(L[begin]), size};
+            scratch.strip_labels[s] = run_ccl(strip_cells, strip_labels, config,
+                                              scratch.workers[worker]);
+        });
+
+    // Number the labels of all strips one after the other.
+    scratch.label_offset.resize(n_strips + 1);
+    scratch.label_offset[0] = 0;
+    for (std::size_t s = 0; s < n_strips; ++s) {
+        scratch.label_offset[s + 1] =
+            scratch.label_offset[s] + scratch.strip_labels[s];
+    }
+    const unsigned int n_labels = scratch.label_offset[n_strips];
+    auto& parent = scratch.label_parent;
+    parent.resize(n_labels);
+    std::iota(parent.begin(), parent.end(), 0u);
+
+    // Merge the labels of the clusters touching across the strip
+    // boundaries, comparing the last column of every strip with the first
+    // column of the next one.
+    for (std::size_t s = 1; s < n_strips; ++s) {
+        const unsigned int boundary = scratch.strip_begin[s];
+        if (cells[boundary].channel1 != cells[boundary - 1].channel1 + 1) {
+            continue;
+        }
+        unsigned int last_begin = boundary - 1;
+        while ((last_begin > scratch.strip_begin[s - 1]) &&
+               (cells[last_begin - 1].channel1 ==
+                cells[boundary - 1].channel1)) {
+            --last_begin;
+        }
+        for (unsigned int i = boundary; (i < scratch.strip_begin[s + 1]) &&
+                                        (cells[i].channel1 ==
+                                         cells[boundary].channel1);
+             ++i) {
+            for (unsigned int j = last_begin; j < boundary; ++j) {
+                if (is_adjacent(cells[i], cells[j])) {
+                    make_union(parent,
+                               find_root(parent,
+                                         scratch.label_offset[s] + L[i] - 1),
+                               find_root(parent, scratch.label_offset[s - 1] +
+                                                     L[j] - 1));
+                }
+            }
+        }
+    }
+
+    // Resolve the equivalences, and translate the labels of the strips.
+    const unsigned int n_clusters = transitive_closure(parent, n_labels);
+    for (std::size_t s = 0; s < n_strips; ++s) {
+        for (unsigned int i = scratch.strip_begin[s];
+             i < scratch.strip_begin[s + 1]; ++i) {
+            L[i] = parent[scratch.label_offset[s] + L[i] - 1];
+        }
+    }
+
+    return n_clusters;
+}
+
+}  // namespace traccc::detail
@@ -0,0 +1,69 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2022 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+#pragma once
+
+// Library include(s).
+#include "traccc/definitions/qualifiers.hpp"
+
+// System include(s).
+#include <cassert>
+
+namespace traccc::detail {
+
+/// Find the root of the set of entry @c e, compressing the path to it
+///
+/// Uses path halving: every visited entry is re-pointed to its grandparent,
+/// which keeps the trees flat without needing a second pass.
+///
+/// @param parent is the parent table of the disjoint sets
+/// @param e is the entry to find the root of
+///
+/// @return the root of @c e
+template <typename parent_vector_t>
+TRACCC_HOST_DEVICE inline unsigned int union_find_root(parent_vector_t& parent,
+                                                       unsigned int e) {
+
+    assert(e < parent.size());
+    while (parent[e] != e) {
+        parent[e] = parent[parent[e]];
+        e = parent[e];
+    }
+    return e;
+}
+
+/// Merge the sets of entries @c e1 and @c e2, using union by rank
+///
+/// @param parent is the parent table of the disjoint sets
+/// @param rank is the rank table of the disjoint sets
+/// @param e1 is the first entry
+/// @param e2 is the second entry
+///
+/// @return the root of the merged set
+template <typename parent_vector_t, typename rank_vector_t>
+TRACCC_HOST_DEVICE inline unsigned int union_find_merge(
+    parent_vector_t& parent, rank_vector_t& rank, unsigned int e1,
+    unsigned int e2) {
+
+    unsigned int r1 = union_find_root(parent, e1);
+    unsigned int r2 = union_find_root(parent, e2);
+    if (r1 == r2) {
+        return r1;
+    }
+    if (rank[r1] < rank[r2]) {
+        const unsigned int tmp = r1;
+        r1 = r2;
+        r2 = tmp;
+    }
+    parent[r2] = r1;
+    if (rank[r1] == rank[r2]) {
+        ++rank[r1];
+    }
+    return r1;
+}
+
+}  // namespace traccc::detail
@@ -0,0 +1,76 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2022 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+#pragma once
+
+// Library include(s).
+#include "traccc/clusterization/clusterization_config.hpp"
+#include "traccc/edm/cell.hpp"
+#include "traccc/edm/measurement.hpp"
+#include "traccc/utils/algorithm.hpp"
+
+// VecMem include(s).
+#include <vecmem/memory/memory_resource.hpp>
+
+// System include(s).
+#include <cstddef>
+#include <functional>
+
+namespace traccc {
+
+/// Host implementation of the partitioned FastSV clusterization
+///
+/// This is a port of the algorithm of @c traccc::cuda::component_connection
+/// to the CPU. The cells of the event are flattened into plain arrays, and
+/// are split into partitions at empty rows, just like on the GPU. Each
+/// partition is then processed by one thread (in place of a CUDA block).
+/// Inside of a partition every FastSV iteration is split into passes over
+/// the cells that have no write conflicts between them (in place of the
+/// threads of the block), so that the compiler can vectorize them. The
+/// only exception is the stochastic hooking, which writes to the parents
+/// of the cells, and stays a scalar loop.
+///
+/// Unlike the CUDA version, the measurements are created with the same
+/// helper functions as in @c traccc::measurement_creation, so the output is
+/// identical to that of @c traccc::clusterization_algorithm. This includes
+/// the cluster links counting from zero for every event of a batch (see
+/// @c traccc::batch_events).
+///
+class fast_sv_clusterization
+    : public algorithm<measurement_container_types::host(
+          const cell_container_types::host&)> {
+
+    public:
+    /// Minimal number of cells in a partition, before it would be closed at
+    /// the next empty row
+    static constexpr std::size_t min_cells_per_partition = 512;
+
+    /// Constructor for fast_sv_clusterization
+    ///
+    /// @param mr is the memory resource to use for the result objects
+    /// @param config is the clusterization configuration
+    ///
+    fast_sv_clusterization(vecmem::memory_resource& mr,
+                           const clusterization_config& config = {});
+
+    /// Construct measurements for each detector module
+    ///
+    /// @param cells The cells for every detector module in the event
+    /// @return The measurements reconstructed for every detector module
+    ///
+    output_type operator()(
+        const cell_container_types::host& cells) const override;
+
+    private:
+    /// The memory resource used by the algorithm
+    std::reference_wrapper<vecmem::memory_resource> m_mr;
+    /// The clusterization configuration
+    clusterization_config m_config;
+
+};  // class fast_sv_clusterization
+
+}  // namespace traccc
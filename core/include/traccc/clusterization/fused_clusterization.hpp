@@ -0,0 +1,83 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2022 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+#pragma once
+
+// Library include(s).
+#include "traccc/clusterization/clusterization_config.hpp"
+#include "traccc/edm/cell.hpp"
+#include "traccc/edm/measurement.hpp"
+#include "traccc/utils/algorithm.hpp"
+
+// VecMem include(s).
+#include <vecmem/memory/memory_resource.hpp>
+
+// System include(s).
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace traccc {
+
+/// Fused connected component labelling and measurement creation
+///
+/// This algorithm produces the same measurements as running
+/// @c traccc::component_connection and @c traccc::measurement_creation one
+/// after the other. But instead of copying the cells of every cluster into
+/// a @c traccc::cluster_container_types::host object, the cells of each
+/// module are only grouped by their cluster label (through their indices),
+/// right after SparseCCL labelled them.
+///
+/// The @c cluster_link of the measurements is the index that the cluster
+/// would have had in the output of @c traccc::component_connection. For a
+/// batch of events (see @c traccc::batch_events) the clusters are counted
+/// from zero for every event, so that the measurements are the same as when
+/// processing the events one by one.
+///
+class fused_clusterization
+    : public algorithm<measurement_container_types::host(
+          const cell_container_types::host&)> {
+
+    public:
+    /// Constructor for fused_clusterization
+    ///
+    /// @param mr is the memory resource to use for the result objects
+    /// @param config is the clusterization configuration
+    ///
+    fused_clusterization(vecmem::memory_resource& mr,
+                         const clusterization_config& config = {});
+
+    /// Construct measurements for each detector module
+    ///
+    /// @param cells The cells for every detector module in the event
+    /// @return The measurements reconstructed for every detector module
+    ///
+    output_type operator()(
+        const cell_container_types::host& cells) const override;
+
+    /// Construct measurements for a subset of the detector modules
+    ///
+    /// The cluster links of the measurements count the clusters of the
+    /// selected modules (of the same event) only.
+    ///
+    /// @param cells The cells for every detector module in the event
+    /// @param modules The indices of the (non-empty) modules to process, in
+    ///                increasing order
+    /// @return The measurements reconstructed for the selected modules
+    ///
+    output_type operator()(const cell_container_types::host& cells,
+                           const std::vector<std::size_t>& modules) const;
+
+    private:
+    /// The memory resource used by the algorithm
+    std::reference_wrapper<vecmem::memory_resource> m_mr;
+    /// The clusterization configuration
+    clusterization_config m_config;
+
+};  // class fused_clusterization
+
+}  // namespace traccc
@@ -8,6 +8,7 @@
 #pragma once
 
 // Library include(s).
+#include "traccc/clusterization/clusterization_config.hpp"
 #include "traccc/edm/cell.hpp"
 #include "traccc/edm/cluster.hpp"
 #include "traccc/edm/measurement.hpp"
@@ -27,6 +28,9 @@ namespace traccc {
 /// for all of the clusters that were identified in that one detector
 /// module.
 ///
+/// The output is sized exactly in a first pass over the cluster headers,
+/// so that the measurements of the modules can then be filled in parallel.
+///
 class measurement_creation : public algorithm<measurement_container_types::host(
                                  const cell_container_types::host &,
                                  const cluster_container_types::host &)> {
@@ -35,8 +39,10 @@ class measurement_creation : public algorithm<measurement_container_types::host(
     /// Measurement_creation algorithm constructor
     ///
     /// @param mr The memory resource to use in the algorithm
+    /// @param config The clusterization configuration
     ///
-    measurement_creation(vecmem::memory_resource &mr);
+    measurement_creation(vecmem::memory_resource &mr,
+                         const clusterization_config &config = {});
 
     /// Callable operator for the connected component, based on one single
     /// module
@@ -53,9 +59,24 @@ class measurement_creation : public algorithm<measurement_container_types::host(
         const cell_container_types::host &cells,
         const cluster_container_types::host &clusters) const override;
 
+    /// Create the measurements of clusters described by cell indices
+    ///
+    /// Gives the same result as the overload taking copies of the cells of
+    /// the clusters.
+    ///
+    /// @param cells are the cells that the clusters were found in
+    /// @param clusters are the clusters, referring to the cells of @c cells
+    ///
+    /// @return a measurement container, with the cluster links of the
+    /// measurements pointing into @c clusters
+    output_type operator()(const cell_container_types::host &cells,
+                           const cluster_index_types::host &clusters) const;
+
     private:
     /// The memory resource used by the algorithm
     std::reference_wrapper<vecmem::memory_resource> m_mr;
+    /// The clusterization configuration
+    clusterization_config m_config;
 
 };  // class measurement_creation
 
@@ -0,0 +1,79 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2022 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+#pragma once
+
+// Library include(s).
+#include "traccc/clusterization/clusterization_config.hpp"
+#include "traccc/clusterization/detail/module_clusterization.hpp"
+#include "traccc/edm/cell.hpp"
+#include "traccc/edm/measurement.hpp"
+
+// VecMem include(s).
+#include <vecmem/memory/memory_resource.hpp>
+
+// System include(s).
+#include <cstddef>
+#include <functional>
+
+namespace traccc {
+
+/// Module-by-module clusterization
+///
+/// Unlike @c traccc::clusterization_algorithm, which needs all the cells of
+/// an event up front, this class receives the cells of one module at a
+/// time, and returns the measurements of that module right away. This
+/// allows the clusterization to overlap with reading the cells, and limits
+/// the memory needed to that of the largest module.
+///
+/// The object keeps scratch memory between the calls, so it must not be
+/// used from multiple threads at the same time. The cluster links of the
+/// measurements keep counting the clusters of all the modules since the
+/// last call to @c reset. So feeding all the modules of an event, in order,
+/// results in the same measurements as @c traccc::clusterization_algorithm
+/// produces for the whole event.
+///
+class streaming_clusterization {
+
+    public:
+    /// Constructor for streaming_clusterization
+    ///
+    /// @param mr is the memory resource to use for the result objects
+    /// @param config is the clusterization configuration (the number of
+    ///               threads is ignored)
+    ///
+    streaming_clusterization(vecmem::memory_resource& mr,
+                             const clusterization_config& config = {});
+
+    /// Construct the measurements of one detector module
+    ///
+    /// @param module The header of the module
+    /// @param cells The cells of the module, sorted in column major
+    /// @return The measurements reconstructed for the module
+    ///
+    measurement_collection_types::host operator()(
+        const cell_module& module, const cell_collection_types::host& cells);
+
+    /// Number of clusters found since the last reset
+    std::size_t n_clusters() const;
+
+    /// Start a new event, counting the cluster links from zero again
+    void reset();
+
+    private:
+    /// The memory resource used by the algorithm
+    std::reference_wrapper<vecmem::memory_resource> m_mr;
+    /// The clusterization configuration
+    clusterization_config m_config;
+    /// Scratch memory re-used for all the modules
+    detail::module_clusterization_scratch m_scratch;
+    /// Number of clusters found since the last reset
+    std::size_t m_n_clusters = 0;
+
+};  // class streaming_clusterization
+
+}  // namespace traccc
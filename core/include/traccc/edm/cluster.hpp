@@ -9,16 +9,268 @@
 
 // Library include(s).
 #include "traccc/definitions/primitives.hpp"
+#include "traccc/definitions/qualifiers.hpp"
 #include "traccc/edm/cell.hpp"
 #include "traccc/edm/container.hpp"
 #include "traccc/geometry/pixel_data.hpp"
+#include "traccc/utils/type_traits.hpp"
+
+// VecMem include(s).
+#include <vecmem/containers/data/vector_view.hpp>
+#include <vecmem/containers/device_vector.hpp>
+#include <vecmem/containers/vector.hpp>
+#include <vecmem/memory/memory_resource.hpp>
 
 // System include(s).
 #include <cstddef>
+#include <type_traits>
 
 namespace traccc {
 
 /// Declare all cluster container types
 using cluster_container_types = container_types<std::size_t, cell>;
 
+/// Collection-like access to the cells of one cluster, described by the
+/// indices of its cells in the cell collection of its module
+///
+/// The cells are not copied, they are accessed through the indices.
+///
+template <typename cell_collection_t, typename index_t>
+class cluster_cells {
+
+    public:
+    /// Iterator over the cells of the cluster
+    class const_iterator {
+        public:
+        TRACCC_HOST_DEVICE
+        const_iterator(const cluster_cells& cluster, unsigned int i)
+            : m_cluster(&cluster), m_i(i) {}
+
+        TRACCC_HOST_DEVICE
+        const cell& operator*() const { return (*m_cluster)[m_i]; }
+        TRACCC_HOST_DEVICE
+        const_iterator& operator++() {
+            ++m_i;
+            return *this;
+        }
+        TRACCC_HOST_DEVICE
+        bool operator==(const const_iterator& other) const {
+            return (m_i == other.m_i);
+        }
+        TRACCC_HOST_DEVICE
+        bool operator!=(const const_iterator& other) const {
+            return (m_i != other.m_i);
+        }
+
+        private:
+        const cluster_cells* m_cluster;
+        unsigned int m_i;
+    };
+
+    /// Constructor from the cells of the module and the indices of the
+    /// cells of the cluster
+    TRACCC_HOST_DEVICE
+    cluster_cells(const cell_collection_t& cells, index_t* indices,
+                  unsigned int size)
+        : m_cells(cells), m_indices(indices), m_size(size) {}
+
+    /// Number of cells in the cluster
+    TRACCC_HOST_DEVICE
+    unsigned int size() const { return m_size; }
+    /// Check if the cluster has no cells
+    TRACCC_HOST_DEVICE
+    bool empty() const { return (m_size == 0); }
+    /// Access one cell of the cluster
+    TRACCC_HOST_DEVICE
+    const cell& operator[](unsigned int i) const {
+        return m_cells[m_indices[i]];
+    }
+    /// Index of one cell of the cluster, in the cells of its module
+    TRACCC_HOST_DEVICE
+    unsigned int index(unsigned int i) const { return m_indices[i]; }
+
+    TRACCC_HOST_DEVICE
+    const_iterator begin() const { return {*this, 0}; }
+    TRACCC_HOST_DEVICE
+    const_iterator end() const { return {*this, m_size}; }
+
+    private:
+    /// The cells of the module of the cluster
+    const cell_collection_t& m_cells;
+    /// The indices of the cells of the cluster
+    index_t* m_indices;
+    /// The number of cells in the cluster
+    unsigned int m_size;
+
+};  // class cluster_cells
+
+/// View of clusters described by the indices of their cells
+///
+/// This is the type that can be passed to device code as-is, see
+/// @c traccc::cluster_index_types.
+///
+template <typename link_t, typename index_t>
+struct cluster_index_view {
+
+    /// Default constructor
+    cluster_index_view() = default;
+
+    /// Constructor from the views of the individual vectors
+    cluster_index_view(const vecmem::data::vector_view<link_t>& links,
+                       const vecmem::data::vector_view<index_t>& offsets,
+                       const vecmem::data::vector_view<index_t>& indices)
+        : module_links(links), cell_offsets(offsets), cell_indices(indices) {}
+
+    /// Constructor from a non-const view
+    template <
+        typename other_link_t, typename other_index_t,
+        std::enable_if_t<details::is_same_nc<link_t, other_link_t>::value,
+                         bool> = true,
+        std::enable_if_t<details::is_same_nc<index_t, other_index_t>::value,
+                         bool> = true>
+    cluster_index_view(
+        const cluster_index_view<other_link_t, other_index_t>& parent)
+        : module_links(parent.module_links),
+          cell_offsets(parent.cell_offsets),
+          cell_indices(parent.cell_indices) {}
+
+    /// View of the module link of every cluster
+    vecmem::data::vector_view<link_t> module_links;
+    /// View of the offsets of the clusters in @c cell_indices
+    vecmem::data::vector_view<index_t> cell_offsets;
+    /// View of the cell indices of all clusters
+    vecmem::data::vector_view<index_t> cell_indices;
+};
+
+/// Device-side access to clusters described by the indices of their cells
+template <typename link_t, typename index_t>
+class cluster_index_device {
+
+    public:
+    /// Constructor from a view
+    template <
+        typename other_link_t, typename other_index_t,
+        std::enable_if_t<details::is_same_nc<link_t, other_link_t>::value,
+                         bool> = true,
+        std::enable_if_t<details::is_same_nc<index_t, other_index_t>::value,
+                         bool> = true>
+    TRACCC_HOST_DEVICE cluster_index_device(
+        const cluster_index_view<other_link_t, other_index_t>& view)
+        : m_module_links(view.module_links),
+          m_cell_offsets(view.cell_offsets),
+          m_cell_indices(view.cell_indices) {}
+
+    /// Number of clusters
+    TRACCC_HOST_DEVICE
+    unsigned int size() const { return m_module_links.size(); }
+    /// Index of the module (in the cell container) of one cluster
+    TRACCC_HOST_DEVICE
+    std::size_t module_link(unsigned int i) const { return m_module_links[i]; }
+    /// Number of cells in one cluster
+    TRACCC_HOST_DEVICE
+    unsigned int n_cells(unsigned int i) const {
+        return m_cell_offsets[i + 1] - m_cell_offsets[i];
+    }
+
+    /// The cells of one cluster, in the cell collection of its module
+    template <typename cell_collection_t>
+    TRACCC_HOST_DEVICE cluster_cells<cell_collection_t, const index_t> cells(
+        const cell_collection_t& module_cells, unsigned int i) const {
+        return {module_cells, &(m_cell_indices[m_cell_offsets[i]]),
+                n_cells(i)};
+    }
+
+    /// The module link of every cluster
+    TRACCC_HOST_DEVICE
+    vecmem::device_vector<link_t>& module_links() { return m_module_links; }
+    /// The offset of every cluster in @c cell_indices, followed by the total
+    /// number of cells
+    TRACCC_HOST_DEVICE
+    vecmem::device_vector<index_t>& cell_offsets() { return m_cell_offsets; }
+    /// The cell indices of all clusters
+    TRACCC_HOST_DEVICE
+    vecmem::device_vector<index_t>& cell_indices() { return m_cell_indices; }
+
+    private:
+    vecmem::device_vector<link_t> m_module_links;
+    vecmem::device_vector<index_t> m_cell_offsets;
+    vecmem::device_vector<index_t> m_cell_indices;
+
+};  // class cluster_index_device
+
+/// Type trait defining the types of clusters described by cell indices
+///
+/// Instead of copying the cells of the clusters (like
+/// @c traccc::cluster_container_types does), every cluster is described by
+/// the module it belongs to, and the indices of its cells in the cell
+/// collection of that module, in the cell container that the clusters were
+/// found in. These indices are local to the module, so they start from zero
+/// for every module. The cell indices of all clusters are stored in one
+/// vector, with cluster @c i taking up the elements
+/// <tt>[cell_offsets[i], cell_offsets[i + 1])</tt> of it.
+///
+struct cluster_index_types {
+
+    /// Host description of the clusters
+    struct host {
+
+        /// Constructor with the memory resource to use
+        explicit host(vecmem::memory_resource* mr)
+            : module_links(mr), cell_offsets(1, 0, mr), cell_indices(mr) {}
+
+        /// Number of clusters
+        std::size_t size() const { return module_links.size(); }
+        /// Number of cells in one cluster
+        unsigned int n_cells(std::size_t i) const {
+            return cell_offsets[i + 1] - cell_offsets[i];
+        }
+
+        /// The cells of one cluster, in the cell container that the clusters
+        /// were found in
+        cluster_cells<cell_collection_types::host, const unsigned int> cells(
+            const cell_container_types::host& cells, std::size_t i) const {
+            return {cells.get_items()[module_links[i]],
+                    cell_indices.data() + cell_offsets[i], n_cells(i)};
+        }
+
+        /// Index of the module (in the cell container) of every cluster
+        vecmem::vector<std::size_t> module_links;
+        /// Offset of every cluster in @c cell_indices, followed by the total
+        /// number of cells
+        vecmem::vector<unsigned int> cell_offsets;
+        /// Indices of the cells of all clusters, in the cells of their
+        /// modules
+        vecmem::vector<unsigned int> cell_indices;
+    };
+
+    /// Non-constant view of the clusters
+    using view = cluster_index_view<std::size_t, unsigned int>;
+    /// Constant view of the clusters
+    using const_view =
+        cluster_index_view<const std::size_t, const unsigned int>;
+
+    /// Non-constant device access to the clusters
+    using device = cluster_index_device<std::size_t, unsigned int>;
+    /// Constant device access to the clusters
+    using const_device =
+        cluster_index_device<const std::size_t, const unsigned int>;
+
+};  // struct cluster_index_types
+
+/// Helper function for making a view out of host clusters (non-const)
+inline cluster_index_types::view get_data(
+    cluster_index_types::host& clusters) {
+    return {vecmem::get_data(clusters.module_links),
+            vecmem::get_data(clusters.cell_offsets),
+            vecmem::get_data(clusters.cell_indices)};
+}
+
+/// Helper function for making a view out of host clusters (const)
+inline cluster_index_types::const_view get_data(
+    const cluster_index_types::host& clusters) {
+    return {vecmem::get_data(clusters.module_links),
+            vecmem::get_data(clusters.cell_offsets),
+            vecmem::get_data(clusters.cell_indices)};
+}
+
 }  // namespace traccc
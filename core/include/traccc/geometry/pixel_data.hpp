@@ -23,6 +23,15 @@ struct pixel_data {
     scalar min_center_y = 0.;
     scalar pitch_x = 1.;
     scalar pitch_y = 1.;
+    /// Number of dimensions of the segmentation: 2 for pixel modules, 1 for
+    /// strip modules (with all cells in the same channel1 column)
+    ///
+    /// For strip modules @c min_center_y and @c pitch_y are placeholders (0
+    /// and 1), not the position and length of the strips. So the second
+    /// local coordinate of their measurements, and its variance of
+    /// pitch_y^2 / 12, carry no information, and must not be used as a
+    /// measured position or error along the strips.
+    unsigned char dimension = 2;
 
     TRACCC_HOST_DEVICE
     vector2 get_pitch() const { return {pitch_x, pitch_y}; };
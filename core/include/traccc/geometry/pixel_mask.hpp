@@ -0,0 +1,96 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2022 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+#pragma once
+
+// Project include(s).
+#include "traccc/definitions/primitives.hpp"
+
+// System include(s).
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace traccc {
+
+/// Set of masked (noisy or dead) pixels, for every detector module
+///
+/// The pixels of every module are kept in a sorted vector, so that the
+/// pixels of a module can be looked up once, and then checked with a binary
+/// search for every cell of the module.
+///
+class pixel_mask {
+
+    public:
+    /// Type holding the (sorted) masked pixels of one module
+    using module_pixels = std::vector<std::uint64_t>;
+
+    /// Encode the channels of a pixel into a single value
+    static std::uint64_t pixel_key(channel_id channel0, channel_id channel1) {
+        return (static_cast<std::uint64_t>(channel1) << 32) | channel0;
+    }
+
+    /// Add a pixel to the mask
+    ///
+    /// @param module The identifier of the module of the pixel
+    /// @param channel0 The first channel of the pixel
+    /// @param channel1 The second channel of the pixel
+    ///
+    void add(geometry_id module, channel_id channel0, channel_id channel1) {
+        module_pixels& pixels = m_pixels[module];
+        const std::uint64_t key = pixel_key(channel0, channel1);
+        auto it = std::lower_bound(pixels.begin(), pixels.end(), key);
+        if ((it == pixels.end()) || (*it != key)) {
+            pixels.insert(it, key);
+        }
+    }
+
+    /// Get the masked pixels of a module
+    ///
+    /// @param module The identifier of the module
+    /// @return The masked pixels of the module, or @c nullptr if it has none
+    ///
+    const module_pixels* find(geometry_id module) const {
+        auto it = m_pixels.find(module);
+        return (it == m_pixels.end()) ? nullptr : &(it->second);
+    }
+
+    /// Check if a given pixel is masked
+    ///
+    /// @param pixels The masked pixels of the module of the pixel
+    /// @param channel0 The first channel of the pixel
+    /// @param channel1 The second channel of the pixel
+    ///
+    static bool contains(const module_pixels& pixels, channel_id channel0,
+                         channel_id channel1) {
+        return std::binary_search(pixels.begin(), pixels.end(),
+                                  pixel_key(channel0, channel1));
+    }
+
+    /// Check if a given pixel is masked
+    ///
+    /// @param module The identifier of the module of the pixel
+    /// @param channel0 The first channel of the pixel
+    /// @param channel1 The second channel of the pixel
+    ///
+    bool contains(geometry_id module, channel_id channel0,
+                  channel_id channel1) const {
+        const module_pixels* pixels = find(module);
+        return (pixels != nullptr) && contains(*pixels, channel0, channel1);
+    }
+
+    /// Check if no pixels are masked at all
+    bool empty() const { return m_pixels.empty(); }
+
+    private:
+    /// The masked pixels of every module that has any
+    std::map<geometry_id, module_pixels> m_pixels;
+
+};  // class pixel_mask
+
+}  // namespace traccc
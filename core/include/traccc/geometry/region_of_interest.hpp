@@ -0,0 +1,73 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2022 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+#pragma once
+
+// Project include(s).
+#include "traccc/definitions/primitives.hpp"
+
+// System include(s).
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+
+namespace traccc {
+
+/// A window in (pseudorapidity, azimuth) around a direction of interest
+struct region_of_interest {
+    /// Pseudorapidity of the centre of the region
+    scalar eta = 0.;
+    /// Azimuth of the centre of the region
+    scalar phi = 0.;
+    /// Half width of the region in pseudorapidity
+    scalar delta_eta = 0.;
+    /// Half width of the region in azimuth
+    scalar delta_phi = 0.;
+};
+
+/// Check if the area spanned by a set of global points overlaps with a
+/// region of interest
+///
+/// The area is approximated by the (eta, phi) bounding box of the points.
+/// The azimuth of the points is taken relative to the first point, and the
+/// offset of that point relative to the centre of the region, so that
+/// both of them may cross the +-pi boundary. (The points need to span less
+/// than pi in azimuth.)
+///
+/// @param roi The region of interest
+/// @param points Global positions, for instance the corners of a module
+/// @return @c true if the points' bounding box overlaps with the region
+///
+template <typename point_container_t>
+inline bool overlaps(const region_of_interest& roi,
+                     const point_container_t& points) {
+
+    static constexpr scalar two_pi = static_cast<scalar>(2. * M_PI);
+
+    scalar min_eta = std::numeric_limits<scalar>::max();
+    scalar max_eta = std::numeric_limits<scalar>::lowest();
+    scalar min_dphi = std::numeric_limits<scalar>::max();
+    scalar max_dphi = std::numeric_limits<scalar>::lowest();
+    const scalar ref_phi = getter::phi(*std::begin(points));
+    for (const point3& p : points) {
+        const scalar eta = getter::eta(p);
+        min_eta = std::min(min_eta, eta);
+        max_eta = std::max(max_eta, eta);
+        const scalar dphi = std::remainder(getter::phi(p) - ref_phi, two_pi);
+        min_dphi = std::min(min_dphi, dphi);
+        max_dphi = std::max(max_dphi, dphi);
+    }
+    const scalar offset = std::remainder(ref_phi - roi.phi, two_pi);
+
+    return (min_eta <= roi.eta + roi.delta_eta) &&
+           (max_eta >= roi.eta - roi.delta_eta) &&
+           (offset + min_dphi <= roi.delta_phi) &&
+           (offset + max_dphi >= -roi.delta_phi);
+}
+
+}  // namespace traccc
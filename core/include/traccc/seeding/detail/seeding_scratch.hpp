@@ -0,0 +1,91 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2022 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+#pragma once
+
+// Project include(s).
+#include "traccc/definitions/primitives.hpp"
+#include "traccc/edm/seed.hpp"
+#include "traccc/seeding/detail/doublet.hpp"
+#include "traccc/seeding/detail/lin_circle.hpp"
+#include "traccc/seeding/detail/triplet.hpp"
+
+// System include(s).
+#include <utility>
+#include <vector>
+
+namespace traccc {
+
+/// Scratch memory used by @c traccc::triplet_finding
+///
+/// Describes the middle-top doublets of one middle spacepoint, as set up by
+/// @c traccc::triplet_finding::sort_mid_top.
+///
+struct triplet_finding_scratch {
+    /// Indices of the middle-top doublets, by increasing cotTheta
+    std::vector<unsigned int> order;
+    /// cotTheta of the middle-top doublets, in the order of @c order
+    std::vector<scalar> cot_theta;
+    /// Largest Er() of the middle-top doublets
+    scalar max_Er = 0.;
+    /// Largest |cotTheta() * iDeltaR()| of the middle-top doublets
+    scalar max_cotTheta_iDeltaR = 0.;
+    /// Largest iDeltaR() of the middle-top doublets
+    scalar max_iDeltaR = 0.;
+    /// Indices of the candidate middle-top doublets of one middle-bottom
+    /// doublet
+    std::vector<unsigned int> candidates;
+    /// Indices of the compared triplets, by increasing curvature
+    std::vector<unsigned int> curvature_order;
+    /// Curvature of the compared triplets, in the order of
+    /// @c curvature_order
+    std::vector<scalar> curvatures;
+    /// Top spacepoint radius of the compared triplets
+    std::vector<scalar> top_r;
+    /// Indices of the triplets in the curvature window of one triplet
+    std::vector<unsigned int> compatible_candidates;
+    /// Top spacepoint radii of the compatible seeds of one triplet
+    std::vector<scalar> compatible_seed_r;
+};
+
+/// Scratch memory used by @c traccc::seed_filtering
+struct seed_filtering_scratch {
+    /// The seeds of the current middle spacepoint
+    seed_collection_types::host seeds_per_spM;
+    /// Sum of the squared y and z coordinates of the bottom and top
+    /// spacepoints of every seed, used for ordering seeds of equal weight
+    std::vector<scalar> yz_sums;
+    /// Indices of the seeds, the best ones first
+    std::vector<unsigned int> order;
+    /// The seeds of the current middle spacepoint that pass the cuts
+    seed_collection_types::host new_seeds;
+};
+
+/// Scratch memory used by @c traccc::seed_finding
+///
+/// It is meant to be re-used for all the middle spacepoints processed by one
+/// thread, so that no memory gets allocated once all of its vectors have
+/// grown to their working size.
+///
+struct seed_finding_scratch {
+    /// Middle-bottom doublets of the current middle spacepoint
+    std::pair<doublet_collection_types::host,
+              lin_circle_collection_types::host>
+        mid_bot;
+    /// Middle-top doublets of the current middle spacepoint
+    std::pair<doublet_collection_types::host,
+              lin_circle_collection_types::host>
+        mid_top;
+    /// Triplets of the current middle spacepoint
+    triplet_collection_types::host triplets;
+    /// Scratch memory of the triplet finding
+    triplet_finding_scratch triplet_finding;
+    /// Scratch memory of the seed filtering
+    seed_filtering_scratch filtering;
+};
+
+}  // namespace traccc
@@ -0,0 +1,90 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2022 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+#pragma once
+
+// Project include(s).
+#include "traccc/definitions/primitives.hpp"
+#include "traccc/edm/internal_spacepoint.hpp"
+#include "traccc/edm/spacepoint.hpp"
+#include "traccc/seeding/detail/spacepoint_grid.hpp"
+#include "traccc/seeding/spacepoint_binning_helper.hpp"
+
+// VecMem include(s).
+#include <vecmem/containers/vector.hpp>
+#include <vecmem/memory/memory_resource.hpp>
+
+namespace traccc {
+
+/// Type trait defining the types of a spacepoint grid stored as
+/// structure-of-arrays
+///
+/// The spacepoints of all bins of a @c traccc::sp_grid are stored one bin
+/// after the other, with every property that the doublet finding selects
+/// the candidates with in a separate vector. Bin @c i takes up the elements
+/// <tt>[bin_offsets[i], bin_offsets[i + 1])</tt> of them, in the same order
+/// as in the original grid. So the @c traccc::sp_location of a spacepoint
+/// identifies it in both grids, and its other properties are read from the
+/// original grid.
+///
+/// It is filled by @c traccc::spacepoint_binning together with the grid,
+/// or can be copied from an existing grid. There is only a host description
+/// for now, as the device doublet finding still uses the original grid.
+///
+struct sp_grid_soa_types {
+
+    /// Host description of the grid
+    struct host {
+
+        /// Constructor with the memory resource to use
+        explicit host(vecmem::memory_resource* mr)
+            : bin_offsets(1, 0, mr), r_bins(mr), r(mr), z(mr) {}
+
+        /// Constructor copying the spacepoints of a grid
+        host(const sp_grid& g2, vecmem::memory_resource* mr) : host(mr) {
+
+            bin_offsets.resize(g2.nbins() + 1);
+            for (unsigned int i = 0; i < g2.nbins(); ++i) {
+                bin_offsets[i + 1] = bin_offsets[i] + g2.bin(i).size();
+            }
+            const unsigned int n_spacepoints = bin_offsets.back();
+            r_bins.reserve(n_spacepoints);
+            r.reserve(n_spacepoints);
+            z.reserve(n_spacepoints);
+            for (unsigned int i = 0; i < g2.nbins(); ++i) {
+                for (const internal_spacepoint<spacepoint>& sp : g2.bin(i)) {
+                    r_bins.push_back(radius_bin(sp.x(), sp.y()));
+                    r.push_back(sp.radius());
+                    z.push_back(sp.z());
+                }
+            }
+        }
+
+        /// Number of bins
+        unsigned int n_bins() const { return bin_offsets.size() - 1; }
+        /// Index of the first spacepoint of one bin
+        unsigned int bin_begin(unsigned int bin) const {
+            return bin_offsets[bin];
+        }
+        /// Index after the last spacepoint of one bin
+        unsigned int bin_end(unsigned int bin) const {
+            return bin_offsets[bin + 1];
+        }
+
+        /// Offset of every bin, followed by the number of spacepoints
+        vecmem::vector<unsigned int> bin_offsets;
+        /// Radius bins of the spacepoints
+        vecmem::vector<unsigned int> r_bins;
+        /// Radii of the spacepoints
+        vecmem::vector<scalar> r;
+        /// z coordinates of the spacepoints
+        vecmem::vector<scalar> z;
+    };
+
+};  // struct sp_grid_soa_types
+
+}  // namespace traccc
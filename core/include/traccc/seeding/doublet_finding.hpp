@@ -11,12 +11,21 @@
 #include "traccc/seeding/detail/doublet.hpp"
 #include "traccc/seeding/detail/singlet.hpp"
 #include "traccc/seeding/detail/spacepoint_grid.hpp"
+#include "traccc/seeding/detail/spacepoint_grid_soa.hpp"
 #include "traccc/seeding/doublet_finding_helper.hpp"
+#include "traccc/seeding/spacepoint_binning_helper.hpp"
 #include "traccc/utils/algorithm.hpp"
 
+// System include(s).
+#include <algorithm>
+
 namespace traccc {
 
 /// Doublet finding to search the combinations of two compatible spacepoints
+///
+/// The spacepoints of every grid bin need to be ordered by radius bin, as done
+/// by @c traccc::spacepoint_binning. Only the spacepoints in the radius bins
+/// of the compatible radius range of every neighbour bin are checked.
 struct doublet_finding
     : public algorithm<std::pair<doublet_collection_types::host,
                                  lin_circle_collection_types::host>(
@@ -64,16 +73,44 @@ struct doublet_finding
         auto phi_bins = g2.axis_p0().zone(spM.phi(), m_config.neighbor_scope);
         auto z_bins = g2.axis_p1().zone(spM.z(), m_config.neighbor_scope);
 
+        // radius range of the compatible spacepoints
+        scalar r_min = 0., r_max = 0.;
+        doublet_finding_helper::radius_window(spM, m_config, bottom, r_min,
+                                              r_max);
+        const std::size_t r_bin_min =
+            r_min > 0. ? static_cast<std::size_t>(r_min) : 0;
+        const std::size_t r_bin_max =
+            r_max > 0. ? static_cast<std::size_t>(r_max) : 0;
+
         // iterator over neighbor bins
         for (auto& phi_bin : phi_bins) {
             for (auto& z_bin : z_bins) {
                 auto bin_idx = phi_bin + z_bin * g2.axis_p0().bins();
 
                 const auto& neighbors = g2.bin(phi_bin, z_bin);
-                for (unsigned int sp_idx = 0; sp_idx < neighbors.size();
+
+                // the bins are ordered by radius bin, so only the
+                // spacepoints in the radius bins of the window need to be
+                // checked
+                const unsigned int first = static_cast<unsigned int>(
+                    std::lower_bound(neighbors.begin(), neighbors.end(),
+                                     r_bin_min,
+                                     [](const auto& sp, std::size_t r_bin) {
+                                         return radius_bin(sp.x(), sp.y()) <
+                                                r_bin;
+                                     }) -
+                    neighbors.begin());
+                for (unsigned int sp_idx = first; sp_idx < neighbors.size();
                      sp_idx++) {
                     const auto& sp_nb = neighbors[sp_idx];
 
+                    if (sp_nb.radius() > r_max) {
+                        if (radius_bin(sp_nb.x(), sp_nb.y()) > r_bin_max) {
+                            break;
+                        }
+                        continue;
+                    }
+
                     if (!doublet_finding_helper::isCompatible(
                             spM, sp_nb, m_config, bottom)) {
                         continue;
@@ -92,6 +129,84 @@ struct doublet_finding
         }
     }
 
+    /// Callable operator for doublet finding of a middle spacepoint, using
+    /// the structure-of-arrays copy of the grid for the candidate search
+    ///
+    /// Produces the same doublets as the overload without @c soa, but only
+    /// reads the contiguous radius bin, radius and z arrays of @c soa for
+    /// rejecting the incompatible spacepoints. @c g2 is only used for the
+    /// accepted ones.
+    ///
+    /// @param g2 is the spacepoint grid
+    /// @param soa is the structure-of-arrays copy of @c g2
+    /// @param l is the location of the current middle spacepoint in the grid
+    /// @param bottom is whether it is for bottom or top spacepoints
+    /// @param o is the output pair of doublets and transformed coordinates
+    void operator()(const sp_grid& g2, const sp_grid_soa_types::host& soa,
+                    const sp_location& l, const bool& bottom,
+                    output_type& o) const {
+        // output
+        auto& doublets = o.first;
+        auto& lin_circles = o.second;
+
+        // middle spacepoint
+        const auto& spM = g2.bin(l.bin_idx)[l.sp_idx];
+        const scalar rM = spM.radius();
+        const scalar zM = spM.z();
+
+        auto phi_bins = g2.axis_p0().zone(spM.phi(), m_config.neighbor_scope);
+        auto z_bins = g2.axis_p1().zone(zM, m_config.neighbor_scope);
+
+        // radius range of the compatible spacepoints
+        scalar r_min = 0., r_max = 0.;
+        doublet_finding_helper::radius_window(spM, m_config, bottom, r_min,
+                                              r_max);
+        const std::size_t r_bin_min =
+            r_min > 0. ? static_cast<std::size_t>(r_min) : 0;
+        const std::size_t r_bin_max =
+            r_max > 0. ? static_cast<std::size_t>(r_max) : 0;
+
+        // iterator over neighbor bins
+        for (auto& phi_bin : phi_bins) {
+            for (auto& z_bin : z_bins) {
+                const unsigned int bin_idx =
+                    phi_bin + z_bin * g2.axis_p0().bins();
+                const unsigned int begin = soa.bin_begin(bin_idx);
+                const unsigned int end = soa.bin_end(bin_idx);
+
+                // the bins are ordered by radius bin, so only the
+                // spacepoints in the radius bins of the window need to be
+                // checked
+                const unsigned int first = static_cast<unsigned int>(
+                    std::lower_bound(soa.r_bins.begin() + begin,
+                                     soa.r_bins.begin() + end, r_bin_min) -
+                    soa.r_bins.begin());
+                for (unsigned int i = first; i < end; i++) {
+
+                    if (soa.r[i] > r_max) {
+                        if (soa.r_bins[i] > r_bin_max) {
+                            break;
+                        }
+                        continue;
+                    }
+
+                    if (!doublet_finding_helper::isCompatible(
+                            rM, zM, soa.r[i], soa.z[i], m_config, bottom)) {
+                        continue;
+                    }
+
+                    const unsigned int sp_idx = i - begin;
+                    lin_circle lin =
+                        doublet_finding_helper::transform_coordinates(
+                            spM, g2.bin(bin_idx)[sp_idx], bottom);
+                    sp_location sp_nb_location = {bin_idx, sp_idx};
+                    doublets.push_back(doublet({l, sp_nb_location}));
+                    lin_circles.push_back(std::move(lin));
+                }
+            }
+        }
+    }
+
     private:
     seedfinder_config m_config;
 };
@@ -16,6 +16,28 @@ namespace traccc {
 
 // helper functions used for both cpu and gpu
 struct doublet_finding_helper {
+    /// Margin (in mm) added to both ends of the radius window of
+    /// @c radius_window, to make sure that rounding can not exclude
+    /// spacepoints that @c isCompatible would accept
+    static constexpr scalar radius_window_margin = 0.01;
+
+    /// Find the radius range of the spacepoints that may form doublets with
+    /// a middle spacepoint
+    ///
+    /// The range is a bit wider than the deltaR cuts of @c isCompatible, so
+    /// it can be used to pre-select the candidates, with @c isCompatible
+    /// still making the final decision.
+    ///
+    /// @param sp1 is middle spacepoint
+    /// @param config is configuration parameter
+    /// @param bottom is whether it is for middle-bottom or middle-top doublet
+    /// @param r_min is the smallest radius of the compatible spacepoints
+    /// @param r_max is the largest radius of the compatible spacepoints
+    static inline TRACCC_HOST_DEVICE void radius_window(
+        const internal_spacepoint<spacepoint>& sp1,
+        const seedfinder_config& config, bool bottom, scalar& r_min,
+        scalar& r_max);
+
     /// Check if two spacepoints form doublets
     ///
     /// @param sp1 is middle spacepoint
@@ -29,6 +51,20 @@ struct doublet_finding_helper {
         const internal_spacepoint<spacepoint>& sp2,
         const seedfinder_config& config, bool bottom);
 
+    /// Check if two spacepoints form doublets, using only their radius and z
+    ///
+    /// @param rM is the radius of the middle spacepoint
+    /// @param zM is the z coordinate of the middle spacepoint
+    /// @param r is the radius of the bottom or top spacepoint
+    /// @param z is the z coordinate of the bottom or top spacepoint
+    /// @param config is configuration parameter
+    /// @param bottom is whether it is for middle-bottom or middle-top doublet
+    ///
+    /// @return boolean value for compatibility
+    static inline TRACCC_HOST_DEVICE bool isCompatible(
+        scalar rM, scalar zM, scalar r, scalar z,
+        const seedfinder_config& config, bool bottom);
+
     /// Do the conformal transformation on doublet's coordinate
     ///
     /// @param sp1 is middle spacepoint
@@ -41,18 +77,41 @@ struct doublet_finding_helper {
         const internal_spacepoint<spacepoint>& sp2, bool bottom);
 };
 
+void doublet_finding_helper::radius_window(
+    const internal_spacepoint<spacepoint>& sp1,
+    const seedfinder_config& config, bool bottom, scalar& r_min,
+    scalar& r_max) {
+
+    if (bottom) {
+        r_min = sp1.radius() - config.deltaRMax - radius_window_margin;
+        r_max = sp1.radius() - config.deltaRMin + radius_window_margin;
+    } else {
+        r_min = sp1.radius() + config.deltaRMin - radius_window_margin;
+        r_max = sp1.radius() + config.deltaRMax + radius_window_margin;
+    }
+}
+
 bool doublet_finding_helper::isCompatible(
     const internal_spacepoint<spacepoint>& sp1,
     const internal_spacepoint<spacepoint>& sp2, const seedfinder_config& config,
     bool bottom) {
 
+    return isCompatible(sp1.radius(), sp1.z(), sp2.radius(), sp2.z(), config,
+                        bottom);
+}
+
+bool doublet_finding_helper::isCompatible(scalar rM, scalar zM, scalar r,
+                                          scalar z,
+                                          const seedfinder_config& config,
+                                          bool bottom) {
+
     if (bottom) {
         // check if R distance is too small, because bins are not R-sorted
-        scalar deltaR = sp1.radius() - sp2.radius();
+        scalar deltaR = rM - r;
         // actually cotTheta * deltaR to avoid division by 0 statements
-        scalar cotTheta = sp1.z() - sp2.z();
+        scalar cotTheta = zM - z;
         // actually zOrigin * deltaR to avoid division by 0 statements
-        scalar zOrigin = sp1.z() * deltaR - sp1.radius() * cotTheta;
+        scalar zOrigin = zM * deltaR - rM * cotTheta;
         if (deltaR > config.deltaRMax || deltaR < config.deltaRMin ||
             std::fabs(cotTheta) > config.cotThetaMax * deltaR ||
             zOrigin < config.collisionRegionMin * deltaR ||
@@ -61,11 +120,11 @@ bool doublet_finding_helper::isCompatible(
         }
     } else {
         // check if R distance is too small, because bins are not R-sorted
-        scalar deltaR = sp2.radius() - sp1.radius();
+        scalar deltaR = r - rM;
         // actually cotTheta * deltaR to avoid division by 0 statements
-        scalar cotTheta = (sp2.z() - sp1.z());
+        scalar cotTheta = (z - zM);
         // actually zOrigin * deltaR to avoid division by 0 statements
-        scalar zOrigin = sp1.z() * deltaR - sp1.radius() * cotTheta;
+        scalar zOrigin = zM * deltaR - rM * cotTheta;
         if (deltaR > config.deltaRMax || deltaR < config.deltaRMin ||
             std::fabs(cotTheta) > config.cotThetaMax * deltaR ||
             zOrigin < config.collisionRegionMin * deltaR ||
@@ -11,6 +11,7 @@
 #include "traccc/edm/seed.hpp"
 #include "traccc/edm/spacepoint.hpp"
 #include "traccc/seeding/detail/seeding_config.hpp"
+#include "traccc/seeding/detail/seeding_scratch.hpp"
 #include "traccc/seeding/detail/spacepoint_grid.hpp"
 #include "traccc/seeding/detail/triplet.hpp"
 
@@ -36,6 +37,21 @@ class seed_filtering {
                     const sp_grid& g2, triplet_collection_types::host& triplets,
                     seed_collection_types::host& seeds) const;
 
+    /// Callable operator for the seed filtering, using scratch memory
+    ///
+    /// @param isp_container is internal spacepoint container
+    /// @param triplets is the vector of triplets per middle spacepoint
+    /// @param scratch is scratch memory, re-used between calls
+    ///
+    /// void interface
+    ///
+    /// @return seeds are the vector of seeds where the new compatible seeds are
+    /// added
+    void operator()(const spacepoint_container_types::host& sp_container,
+                    const sp_grid& g2, triplet_collection_types::host& triplets,
+                    seed_collection_types::host& seeds,
+                    seed_filtering_scratch& scratch) const;
+
     private:
     /// Seed filter configuration
     seedfilter_config m_filter_config;
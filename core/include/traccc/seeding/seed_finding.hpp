@@ -11,7 +11,9 @@
 #include "traccc/edm/seed.hpp"
 #include "traccc/edm/spacepoint.hpp"
 #include "traccc/seeding/detail/seeding_config.hpp"
+#include "traccc/seeding/detail/seeding_scratch.hpp"
 #include "traccc/seeding/detail/spacepoint_grid.hpp"
+#include "traccc/seeding/detail/spacepoint_grid_soa.hpp"
 #include "traccc/seeding/doublet_finding.hpp"
 #include "traccc/seeding/seed_filtering.hpp"
 #include "traccc/seeding/triplet_finding.hpp"
@@ -20,6 +22,14 @@
 namespace traccc {
 
 /// Seed finding
+///
+/// The spacepoints of every grid bin need to be ordered by radius bin, as
+/// done by @c traccc::spacepoint_binning.
+///
+/// The bins of middle spacepoints can be processed on multiple threads. The
+/// seeds are always returned in the order of the bins, the same as with a
+/// single thread.
+///
 class seed_finding
     : public algorithm<seed_collection_types::host(
           const spacepoint_container_types::host&, const sp_grid&)> {
@@ -29,9 +39,12 @@ class seed_finding
     ///
     /// @param find_config is seed finder configuration parameters
     /// @param filter_config is the seed filter configuration
+    /// @param n_threads is the number of threads to process the bins of
+    ///                  middle spacepoints with, the calling thread included
     ///
     seed_finding(const seedfinder_config& find_config,
-                 const seedfilter_config& filter_config);
+                 const seedfilter_config& filter_config,
+                 unsigned int n_threads = 1);
 
     /// Callable operator for the seed finding
     ///
@@ -42,13 +55,57 @@ class seed_finding
     output_type operator()(const spacepoint_container_types::host& sp_container,
                            const sp_grid& g2) const override;
 
+    /// Callable operator for the seed finding, using the
+    /// structure-of-arrays description of the grid in the doublet finding
+    ///
+    /// Finds the same seeds as the overload without @c soa.
+    ///
+    /// @param sp_container All spacepoints in the event
+    /// @param g2 The same spacepoints arranged in a 2D Phi-Z grid
+    /// @param soa The structure-of-arrays description of @c g2, as filled
+    ///            by @c traccc::spacepoint_binning
+    /// @return seed_collection is the vector of seeds per event
+    ///
+    output_type operator()(const spacepoint_container_types::host& sp_container,
+                           const sp_grid& g2,
+                           const sp_grid_soa_types::host& soa) const;
+
     private:
+    /// Find the seeds of all bins of middle spacepoints
+    ///
+    /// @param sp_container All spacepoints in the event
+    /// @param g2 The same spacepoints arranged in a 2D Phi-Z grid
+    /// @param soa The structure-of-arrays description of @c g2, or
+    ///            @c nullptr to use @c g2 in the doublet finding
+    /// @return seed_collection is the vector of seeds per event
+    ///
+    output_type find_all_seeds(
+        const spacepoint_container_types::host& sp_container,
+        const sp_grid& g2, const sp_grid_soa_types::host* soa) const;
+
+    /// Find the seeds of the middle spacepoints of one bin
+    ///
+    /// @param sp_container All spacepoints in the event
+    /// @param g2 The same spacepoints arranged in a 2D Phi-Z grid
+    /// @param soa The structure-of-arrays description of @c g2, or
+    ///            @c nullptr to use @c g2 in the doublet finding
+    /// @param i The index of the bin of the middle spacepoints
+    /// @param scratch The scratch memory of the calling thread
+    /// @param seeds The collection that the seeds are appended to
+    ///
+    void find_seeds(const spacepoint_container_types::host& sp_container,
+                    const sp_grid& g2, const sp_grid_soa_types::host* soa,
+                    unsigned int i, seed_finding_scratch& scratch,
+                    output_type& seeds) const;
+
     /// Algorithm performing the doublet finding
     doublet_finding m_doublet_finding;
     /// Algorithm performing the triplet finding
     triplet_finding m_triplet_finding;
     /// Algorithm performing the seed selection
     seed_filtering m_seed_filtering;
+    /// The number of threads to use
+    unsigned int m_n_threads;
 
 };  // class seed_finding
 
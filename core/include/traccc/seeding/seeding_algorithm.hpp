@@ -17,6 +17,9 @@
 // VecMem include(s).
 #include <vecmem/memory/memory_resource.hpp>
 
+// System include(s).
+#include <functional>
+
 namespace traccc {
 
 /// Main algorithm for performing the track seeding on the CPU
@@ -27,8 +30,10 @@ class seeding_algorithm : public algorithm<seed_collection_types::host(
     /// Constructor for the seed finding algorithm
     ///
     /// @param mr The memory resource to use
+    /// @param n_threads The number of threads to use for the spacepoint
+    ///                  binning and the seed finding
     ///
-    seeding_algorithm(vecmem::memory_resource& mr);
+    seeding_algorithm(vecmem::memory_resource& mr, unsigned int n_threads = 1);
 
     /// Operator executing the algorithm.
     ///
@@ -39,6 +44,8 @@ class seeding_algorithm : public algorithm<seed_collection_types::host(
         const spacepoint_container_types::host& spacepoints) const override;
 
     private:
+    /// The memory resource to use
+    std::reference_wrapper<vecmem::memory_resource> m_mr;
     /// Sub-algorithm performing the spacepoint binning
     spacepoint_binning m_spacepoint_binning;
     /// Sub-algorithm performing the seed finding
@@ -11,6 +11,7 @@
 #include "traccc/edm/spacepoint.hpp"
 #include "traccc/seeding/detail/seeding_config.hpp"
 #include "traccc/seeding/detail/spacepoint_grid.hpp"
+#include "traccc/seeding/detail/spacepoint_grid_soa.hpp"
 #include "traccc/utils/algorithm.hpp"
 
 // System include(s).
@@ -19,6 +20,10 @@
 namespace traccc {
 
 /// spacepoint binning
+///
+/// The spacepoints of every grid bin are ordered by their radius bin (see
+/// @c traccc::radius_bin), and by their position in the container within
+/// one radius bin.
 class spacepoint_binning
     : public algorithm<sp_grid(const spacepoint_container_types::host&)> {
 
@@ -28,10 +33,12 @@ class spacepoint_binning
     /// @param config is seed finder configuration parameters
     /// @param grid_config is for spacepoint grid parameter
     /// @param mr is the vecmem memory resource
+    /// @param n_threads is the number of threads to bin the spacepoints
+    ///                  with, the calling thread included
     ///
     spacepoint_binning(const seedfinder_config& config,
                        const spacepoint_grid_config& grid_config,
-                       vecmem::memory_resource& mr);
+                       vecmem::memory_resource& mr, unsigned int n_threads = 1);
 
     /// Operator executing the algorithm
     ///
@@ -41,11 +48,28 @@ class spacepoint_binning
     output_type operator()(
         const spacepoint_container_types::host& sp_container) const override;
 
+    /// Operator executing the algorithm, also filling the
+    /// structure-of-arrays description of the grid
+    ///
+    /// @param sp_container All of the spacepoints of the event
+    /// @param soa The structure-of-arrays description of the returned grid,
+    ///            to be used with the doublet finding
+    /// @return The spacepoints arranged in a Phi-Z grid
+    ///
+    output_type operator()(const spacepoint_container_types::host& sp_container,
+                           sp_grid_soa_types::host& soa) const;
+
     private:
+    /// Fill the grid, and optionally its structure-of-arrays description
+    output_type fill(const spacepoint_container_types::host& sp_container,
+                     sp_grid_soa_types::host* soa) const;
+
     seedfinder_config m_config;
     spacepoint_grid_config m_grid_config;
     std::pair<output_type::axis_p0_type, output_type::axis_p1_type> m_axes;
     std::reference_wrapper<vecmem::memory_resource> m_mr;
+    /// The number of threads to use
+    unsigned int m_n_threads;
 };
 
 }  // namespace traccc
@@ -62,6 +62,17 @@ inline std::pair<detray::axis::circular<>, detray::axis::regular<>> get_axes(
     return {m_phi_axis, m_z_axis};
 }
 
+/// Radius bin of a spacepoint
+///
+/// The spacepoints of every grid bin are ordered by this index, see
+/// @c traccc::spacepoint_binning.
+///
+/// @param x is the x coordinate of the spacepoint relative to the beam
+/// @param y is the y coordinate of the spacepoint relative to the beam
+inline TRACCC_HOST_DEVICE size_t radius_bin(scalar x, scalar y) {
+    return static_cast<size_t>(getter::perp(vector2{x, y}));
+}
+
 inline TRACCC_HOST_DEVICE size_t is_valid_sp(const seedfinder_config& config,
                                              const spacepoint& sp) {
     if (sp.z() > config.zMax || sp.z() < config.zMin) {
@@ -71,8 +82,8 @@ inline TRACCC_HOST_DEVICE size_t is_valid_sp(const seedfinder_config& config,
     if (spPhi > config.phiMax || spPhi < config.phiMin) {
         return detray::detail::invalid_value<size_t>();
     }
-    size_t r_index = getter::perp(
-        vector2{sp.x() - config.beamPos[0], sp.y() - config.beamPos[1]});
+    size_t r_index =
+        radius_bin(sp.x() - config.beamPos[0], sp.y() - config.beamPos[1]);
 
     if (r_index < config.get_num_rbins()) {
         return r_index;
@@ -9,10 +9,16 @@
 
 #include "traccc/edm/internal_spacepoint.hpp"
 #include "traccc/seeding/detail/doublet.hpp"
+#include "traccc/seeding/detail/seeding_scratch.hpp"
 #include "traccc/seeding/detail/triplet.hpp"
 #include "traccc/seeding/triplet_finding_helper.hpp"
 #include "traccc/utils/algorithm.hpp"
 
+// System include(s).
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
 namespace traccc {
 
 /// Triplet finding to search the compatible combintations of two doublets which
@@ -55,6 +61,10 @@ struct triplet_finding : public algorithm<triplet_collection_types::host(
     /// @param lin_circles_mid_top is transformed coordinates of
     /// doublets_mid_top
     ///
+    /// The triplets are appended to @c o, and then all triplets of @c o
+    /// (not only the new ones) are compared with each other for the weight
+    /// increase of compatible seeds.
+    ///
     /// void interface
     ///
     /// @return a vector of triplets
@@ -63,6 +73,96 @@ struct triplet_finding : public algorithm<triplet_collection_types::host(
         const doublet_collection_types::host& doublets_mid_top,
         const lin_circle_collection_types::host& lin_circles_mid_top,
         output_type& o) const {
+        triplet_finding_scratch scratch;
+        sort_mid_top(lin_circles_mid_top, scratch);
+        find_compatible(g2, mid_bot, lb, doublets_mid_top, lin_circles_mid_top,
+                        o, scratch);
+        compatible_seed_weights(g2, o, 0, scratch);
+    }
+
+    /// Prepare the middle-top doublets of a middle spacepoint for the
+    /// triplet finding
+    ///
+    /// @param lin_circles_mid_top is transformed coordinates of the
+    /// middle-top doublets
+    /// @param scratch is the scratch memory to set up
+    void sort_mid_top(
+        const lin_circle_collection_types::host& lin_circles_mid_top,
+        triplet_finding_scratch& scratch) const {
+
+        const unsigned int n_tops = lin_circles_mid_top.size();
+        scratch.order.resize(n_tops);
+        std::iota(scratch.order.begin(), scratch.order.end(), 0u);
+        std::sort(scratch.order.begin(), scratch.order.end(),
+                  [&](unsigned int a, unsigned int b) {
+                      return lin_circles_mid_top[a].cotTheta() <
+                             lin_circles_mid_top[b].cotTheta();
+                  });
+        scratch.cot_theta.resize(n_tops);
+        scratch.max_Er = 0.;
+        scratch.max_cotTheta_iDeltaR = 0.;
+        scratch.max_iDeltaR = 0.;
+        for (unsigned int i = 0; i < n_tops; ++i) {
+            const lin_circle& lt = lin_circles_mid_top[scratch.order[i]];
+            scratch.cot_theta[i] = lt.cotTheta();
+            scratch.max_Er = std::max(scratch.max_Er, lt.Er());
+            scratch.max_cotTheta_iDeltaR =
+                std::max(scratch.max_cotTheta_iDeltaR,
+                         std::abs(lt.cotTheta() * lt.iDeltaR()));
+            scratch.max_iDeltaR = std::max(scratch.max_iDeltaR, lt.iDeltaR());
+        }
+    }
+
+    /// Triplet finding per middle-bottom doublet, for all middle-bottom
+    /// doublets of a middle spacepoint in turn
+    ///
+    /// The triplets are appended to @c o. Unlike with @c operator(), only
+    /// the newly found triplets are compared with each other for the weight
+    /// increase of compatible seeds, the triplets already in @c o (of the
+    /// previous middle-bottom doublets) are left untouched.
+    ///
+    /// @param mid_bot is the current middle-bottom doublets
+    /// @param lb is transformed coordinate of mid_bot
+    /// @param doublets_mid_top is the vector of middle-top doublets which share
+    /// same middle spacepoint with current middle-bottom doublet
+    /// @param lin_circles_mid_top is transformed coordinates of
+    /// doublets_mid_top
+    /// @param o is the collection the triplets are appended to
+    /// @param scratch is scratch memory, set up for @c lin_circles_mid_top
+    /// by @c sort_mid_top
+    void append_triplets(
+        const sp_grid& g2, const doublet& mid_bot, const lin_circle& lb,
+        const doublet_collection_types::host& doublets_mid_top,
+        const lin_circle_collection_types::host& lin_circles_mid_top,
+        output_type& o, triplet_finding_scratch& scratch) const {
+        const std::size_t first_triplet = o.size();
+        find_compatible(g2, mid_bot, lb, doublets_mid_top, lin_circles_mid_top,
+                        o, scratch);
+        compatible_seed_weights(g2, o, first_triplet, scratch);
+    }
+
+    /// Find the triplets of a middle-bottom doublet
+    ///
+    /// Only the middle-top doublets with a cotTheta close enough to that of
+    /// the middle-bottom doublet to pass the scattering cut are checked.
+    /// They are checked in their original order, so the triplets are the
+    /// same as when checking all of them. The weights of the triplets do
+    /// not include the compatible seeds yet.
+    ///
+    /// @param mid_bot is the current middle-bottom doublets
+    /// @param lb is transformed coordinate of mid_bot
+    /// @param doublets_mid_top is the vector of middle-top doublets which share
+    /// same middle spacepoint with current middle-bottom doublet
+    /// @param lin_circles_mid_top is transformed coordinates of
+    /// doublets_mid_top
+    /// @param o is the collection the triplets are appended to
+    /// @param scratch is scratch memory, set up for @c lin_circles_mid_top
+    /// by @c sort_mid_top
+    void find_compatible(
+        const sp_grid& g2, const doublet& mid_bot, const lin_circle& lb,
+        const doublet_collection_types::host& doublets_mid_top,
+        const lin_circle_collection_types::host& lin_circles_mid_top,
+        output_type& o, triplet_finding_scratch& scratch) const {
         // output
         auto& triplets = o;
 
@@ -76,7 +176,24 @@ struct triplet_finding : public algorithm<triplet_collection_types::host(
             m_config.sigmaScattering * m_config.sigmaScattering;
         scalar curvature, impact_parameter;
 
-        for (size_t i = 0; i < doublets_mid_top.size(); ++i) {
+        // find the middle-top doublets in the compatible cotTheta range
+        const scalar max_delta = triplet_finding_helper::max_delta_cotTheta(
+            spM, lb, scratch.max_Er, scratch.max_cotTheta_iDeltaR,
+            scratch.max_iDeltaR, scatteringInRegion2);
+        auto& candidates = scratch.candidates;
+        candidates.clear();
+        for (auto it = std::lower_bound(scratch.cot_theta.begin(),
+                                        scratch.cot_theta.end(),
+                                        lb.cotTheta() - max_delta);
+             (it != scratch.cot_theta.end()) &&
+             (*it <= lb.cotTheta() + max_delta);
+             ++it) {
+            candidates.push_back(
+                scratch.order[it - scratch.cot_theta.begin()]);
+        }
+        std::sort(candidates.begin(), candidates.end());
+
+        for (unsigned int i : candidates) {
             auto& mid_top = doublets_mid_top[i];
             auto& lt = lin_circles_mid_top[i];
 
@@ -94,50 +211,93 @@ struct triplet_finding : public algorithm<triplet_collection_types::host(
                  -impact_parameter * m_filter_config.impactWeightFactor,
                  lb.Zo()});
         }
+    }
+
+    /// Increase the weights of triplets for their compatible seeds
+    ///
+    /// Every triplet of <tt>[first_triplet, triplets.size())</tt> is
+    /// compared with the other triplets of that range, which have a
+    /// curvature within deltaInvHelixDiameter of its own. For this the
+    /// triplets are ordered by curvature, so that the ones in the window
+    /// of every triplet can be found with two pointers. They are visited
+    /// in their original order, which decides which of them are counted
+    /// before reaching the compatible seed limit.
+    ///
+    /// @param triplets is the triplet collection to update
+    /// @param first_triplet is the index of the first triplet to consider
+    /// @param scratch is scratch memory
+    void compatible_seed_weights(const sp_grid& g2, output_type& triplets,
+                                 std::size_t first_triplet,
+                                 triplet_finding_scratch& scratch) const {
+
+        // order the triplets by curvature, so that the triplets in the
+        // curvature window of every triplet can be found with two pointers
+        const unsigned int n_triplets = triplets.size() - first_triplet;
+        auto& curvature_order = scratch.curvature_order;
+        curvature_order.resize(n_triplets);
+        std::iota(curvature_order.begin(), curvature_order.end(), 0u);
+        std::stable_sort(curvature_order.begin(), curvature_order.end(),
+                         [&](unsigned int a, unsigned int b) {
+                             return triplets[first_triplet + a].curvature <
+                                    triplets[first_triplet + b].curvature;
+                         });
+        auto& curvatures = scratch.curvatures;
+        curvatures.resize(n_triplets);
+        for (unsigned int k = 0; k < n_triplets; ++k) {
+            const auto& t = triplets[first_triplet + curvature_order[k]];
+            curvatures[k] = t.curvature;
+        }
+        auto& top_r = scratch.top_r;
+        top_r.resize(n_triplets);
+        for (unsigned int i = 0; i < n_triplets; ++i) {
+            auto& spT_idx = triplets[first_triplet + i].sp3;
+            top_r[i] = g2.bin(spT_idx.bin_idx)[spT_idx.sp_idx].radius();
+        }
 
-        for (size_t i = 0; i < triplets.size(); ++i) {
-            auto& current_triplet = triplets[i];
-            auto& spT_idx = current_triplet.sp3;
-            auto& current_spT = g2.bin(spT_idx.bin_idx)[spT_idx.sp_idx];
-            const auto& currentTop_r = current_spT.radius();
+        auto& compatibleSeedR = scratch.compatible_seed_r;
+        auto& candidate_triplets = scratch.compatible_candidates;
+        unsigned int lower = 0, upper = 0;
+        for (unsigned int k = 0; k < n_triplets; ++k) {
+            const unsigned int i = curvature_order[k];
+            auto& current_triplet = triplets[first_triplet + i];
+            const auto& currentTop_r = top_r[i];
 
             // if two compatible seeds with high distance in r are found,
             // compatible seeds span 5 layers
             // -> very good seed
-            std::vector<scalar> compatibleSeedR;
+            compatibleSeedR.clear();
             scalar lowerLimitCurv = current_triplet.curvature -
                                     m_filter_config.deltaInvHelixDiameter;
             scalar upperLimitCurv = current_triplet.curvature +
                                     m_filter_config.deltaInvHelixDiameter;
 
-            for (size_t j = 0; j < triplets.size(); ++j) {
+            // the triplets with a curvature difference within limits, in
+            // their original order, which decides which of them are counted
+            // before reaching the compatible seed limit
+            while ((lower < n_triplets) &&
+                   (curvatures[lower] < lowerLimitCurv)) {
+                ++lower;
+            }
+            while ((upper < n_triplets) &&
+                   (curvatures[upper] <= upperLimitCurv)) {
+                ++upper;
+            }
+            candidate_triplets.assign(curvature_order.begin() + lower,
+                                      curvature_order.begin() + upper);
+            std::sort(candidate_triplets.begin(), candidate_triplets.end());
+
+            for (unsigned int j : candidate_triplets) {
                 if (i == j) {
                     continue;
                 }
 
-                auto& other_triplet = triplets[j];
-                auto& other_spT_idx = other_triplet.sp3;
-                auto& other_spT =
-                    g2.bin(other_spT_idx.bin_idx)[other_spT_idx.sp_idx];
-
                 // compared top SP should have at least deltaRMin distance
-                const auto& otherTop_r = other_spT.radius();
+                const auto& otherTop_r = top_r[j];
                 scalar deltaR = currentTop_r - otherTop_r;
                 if (std::abs(deltaR) < m_filter_config.deltaRMin) {
                     continue;
                 }
 
-                // curvature difference within limits?
-                // TODO: how much slower than sorting all vectors by curvature
-                // and breaking out of loop? i.e. is vector size large (e.g. in
-                // jets?)
-                if (other_triplet.curvature < lowerLimitCurv) {
-                    continue;
-                }
-                if (other_triplet.curvature > upperLimitCurv) {
-                    continue;
-                }
-
                 bool newCompSeed = true;
                 for (scalar previousDiameter : compatibleSeedR) {
                     // original ATLAS code uses higher min distance for 2nd
@@ -34,6 +34,28 @@ struct triplet_finding_helper {
         const lin_circle& lt, const seedfinder_config& config,
         const scalar& iSinTheta2, const scalar& scatteringInRegion2,
         scalar& curvature, scalar& impact_parameter);
+
+    /// Largest cotTheta difference between a middle-bottom and a middle-top
+    /// doublet that @c isCompatible may accept
+    ///
+    /// The error of the cotTheta difference is estimated from above using
+    /// the largest values of the middle-top doublet properties that it
+    /// depends on. A relative margin protects against rounding.
+    ///
+    /// @param spM is middle spacepoint
+    /// @param lb is transformed coordinate of middle-bottom doublet
+    /// @param max_Er is the largest Er() of the middle-top doublets
+    /// @param max_cotTheta_iDeltaR is the largest |cotTheta() * iDeltaR()|
+    /// of the middle-top doublets
+    /// @param max_iDeltaR is the largest iDeltaR() of the middle-top doublets
+    /// @param scatteringInRegion2 is the threshold for scattering angle for the
+    /// lower pT cut
+    ///
+    /// @return the largest compatible |cotTheta difference|
+    static inline TRACCC_HOST_DEVICE scalar max_delta_cotTheta(
+        const internal_spacepoint<spacepoint>& spM, const lin_circle& lb,
+        const scalar& max_Er, const scalar& max_cotTheta_iDeltaR,
+        const scalar& max_iDeltaR, const scalar& scatteringInRegion2);
 };
 
 bool triplet_finding_helper::isCompatible(
@@ -125,4 +147,21 @@ bool triplet_finding_helper::isCompatible(
     return true;
 }
 
+scalar triplet_finding_helper::max_delta_cotTheta(
+    const internal_spacepoint<spacepoint>& spM, const lin_circle& lb,
+    const scalar& max_Er, const scalar& max_cotTheta_iDeltaR,
+    const scalar& max_iDeltaR, const scalar& scatteringInRegion2) {
+    // upper limit of error2 in isCompatible
+    scalar max_error2 =
+        max_Er + lb.Er() +
+        2 *
+            (std::abs(lb.cotTheta() * spM.varianceR()) * max_cotTheta_iDeltaR +
+             spM.varianceZ() * max_iDeltaR) *
+            lb.iDeltaR();
+
+    // isCompatible rejects all doublets with
+    // |deltaCotTheta| - error > sqrt(scatteringInRegion2)
+    return (std::sqrt(max_error2) + std::sqrt(scatteringInRegion2)) * 1.001f;
+}
+
 }  // namespace traccc
@@ -0,0 +1,128 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2022 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+#pragma once
+
+// Library include(s).
+#include "traccc/definitions/primitives.hpp"
+#include "traccc/edm/cell.hpp"
+
+// VecMem include(s).
+#include <vecmem/memory/memory_resource.hpp>
+
+// System include(s).
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace traccc {
+
+/// Concatenate the cells of multiple events into one batch
+///
+/// The @c event field of the module headers is set to the index of the
+/// event in @c events, so that the results of the algorithms run on the
+/// batch can be split up again with @c traccc::event_ranges and
+/// @c traccc::split_events.
+///
+/// All the host algorithms of the clusterization chain keep the modules of
+/// their input in order, and identify modules by their position in the
+/// container (not by their geometry ID), so they can process such batches
+/// as they would process a single event.
+///
+/// @param events The cells of the individual events
+/// @param mr The memory resource to use for the batch
+/// @return The cells of all events, one event after the other
+///
+inline cell_container_types::host batch_events(
+    const std::vector<cell_container_types::host>& events,
+    vecmem::memory_resource& mr) {
+
+    std::size_t n_modules = 0;
+    for (const cell_container_types::host& event : events) {
+        n_modules += event.size();
+    }
+
+    cell_container_types::host result(n_modules, &mr);
+    std::size_t module = 0;
+    for (std::size_t e = 0; e < events.size(); ++e) {
+        for (std::size_t i = 0; i < events[e].size(); ++i, ++module) {
+            result.get_headers()[module] = events[e].get_headers()[i];
+            result.get_headers()[module].event = e;
+            result.get_items()[module] = events[e].get_items()[i];
+        }
+    }
+
+    return result;
+}
+
+/// Find the range of the entries of every event in a batch
+///
+/// @param headers The module headers of a container made from a batch
+///                created by @c traccc::batch_events
+/// @param n_events The number of events in the batch
+/// @return The index of the first entry of every event, followed by the
+///         total number of entries (so events without any entries are
+///         represented by empty ranges)
+///
+template <typename header_vector_t>
+inline std::vector<std::size_t> event_ranges(const header_vector_t& headers,
+                                             std::size_t n_events) {
+
+    std::vector<std::size_t> result(n_events + 1, headers.size());
+    std::size_t entry = 0;
+    for (std::size_t e = 0; e < n_events; ++e) {
+        result[e] = entry;
+        while ((entry < headers.size()) && (headers[entry].event == e)) {
+            ++entry;
+        }
+    }
+    // The entries have to be ordered by event, and belong to the batch.
+    assert(entry == headers.size());
+
+    return result;
+}
+
+/// Split a container made from a batch of events into the single events
+///
+/// This works for any container with one entry per detector module, so
+/// also for the spacepoints (that don't record the event in their headers)
+/// when using the ranges found for the measurements they were made from.
+///
+/// The cluster links of the measurements are not changed. The host
+/// clusterization algorithms already count them from zero for every event
+/// of the batch, so they index the clusters of their own event.
+///
+/// @param batch The container made from a batch of events
+/// @param ranges The ranges of the entries of the events, as found by
+///               @c traccc::event_ranges
+/// @param mr The memory resource to use for the results
+/// @return One container per event
+///
+template <typename container_t>
+inline std::vector<container_t> split_events(
+    const container_t& batch, const std::vector<std::size_t>& ranges,
+    vecmem::memory_resource& mr) {
+
+    assert(ranges.empty() == false);
+    assert(ranges.back() == batch.size());
+
+    std::vector<container_t> result;
+    result.reserve(ranges.size() - 1);
+    for (std::size_t e = 0; e + 1 < ranges.size(); ++e) {
+        container_t event(ranges[e + 1] - ranges[e], &mr);
+        for (std::size_t i = ranges[e]; i < ranges[e + 1]; ++i) {
+            event.get_headers()[i - ranges[e]] = batch.get_headers()[i];
+            event.get_items()[i - ranges[e]] = batch.get_items()[i];
+        }
+        result.push_back(std::move(event));
+    }
+
+    return result;
+}
+
+}  // namespace traccc
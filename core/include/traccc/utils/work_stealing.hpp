@@ -0,0 +1,158 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2022 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+#pragma once
+
+// System include(s).
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+namespace traccc {
+
+/// Order task indices by decreasing weight
+///
+/// Tasks with the same weight keep their original relative order, so the
+/// resulting schedule is fully reproducible.
+///
+/// @param weights The (estimated) cost of every task
+/// @return The task indices, heaviest task first
+///
+template <typename weight_t>
+inline std::vector<std::size_t> largest_first(
+    const std::vector<weight_t>& weights) {
+
+    std::vector<std::size_t> order(weights.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&weights](std::size_t a, std::size_t b) {
+                         return weights[a] > weights[b];
+                     });
+    return order;
+}
+
+/// Execute a function for a list of tasks on a pool of work-stealing threads
+///
+/// The tasks are dealt out round-robin, in the order in which they are
+/// given, to one queue per worker. Every worker processes its own queue
+/// front-to-back, and once that runs dry it steals from the back of the
+/// other workers' queues. Giving the tasks heaviest-first (see
+/// @c traccc::largest_first) thus gives every worker a big task to start
+/// with, while the small tasks at the end balance out the load.
+///
+/// The calling thread takes part in the processing as worker 0. With
+/// @c n_threads <= 1 the tasks are executed on the calling thread, in the
+/// order given.
+///
+/// The first exception thrown by @c func stops the processing, and is
+/// re-thrown on the calling thread once all workers have finished.
+///
+/// @param tasks The (indices of the) tasks to execute
+/// @param n_threads The maximal number of threads to use
+/// @param func Callable with a <tt>(std::size_t task, unsigned int
+///             worker)</tt> signature. @c worker is always smaller than
+///             @c n_threads, and can be used to index per-thread scratch
+///             memory.
+///
+template <typename function_t>
+inline void work_stealing_for_each(const std::vector<std::size_t>& tasks,
+                                   unsigned int n_threads, function_t&& func) {
+
+    // Decide how many workers to use.
+    const unsigned int n_workers = static_cast<unsigned int>(
+        std::min<std::size_t>(std::max(n_threads, 1u), tasks.size()));
+
+    // Execute everything in the current thread if that's all that's needed.
+    if (n_workers <= 1) {
+        for (std::size_t task : tasks) {
+            func(task, 0u);
+        }
+        return;
+    }
+
+    // Set up the per-worker task queues.
+    struct task_queue {
+        std::mutex mutex;
+        std::deque<std::size_t> tasks;
+    };
+    std::vector<task_queue> queues(n_workers);
+    for (std::size_t i = 0; i < tasks.size(); ++i) {
+        queues[i % n_workers].tasks.push_back(tasks[i]);
+    }
+
+    // Helper for retrieving the next task for a given worker.
+    auto next_task = [&queues, n_workers](unsigned int worker,
+                                          std::size_t& task) -> bool {
+        // Take the next task from the worker's own queue.
+        {
+            task_queue& own = queues[worker];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.tasks.empty()) {
+                task = own.tasks.front();
+                own.tasks.pop_front();
+                return true;
+            }
+        }
+        // Steal from the back of the other workers' queues.
+        for (unsigned int i = 1; i < n_workers; ++i) {
+            task_queue& victim = queues[(worker + i) % n_workers];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = victim.tasks.back();
+                victim.tasks.pop_back();
+                return true;
+            }
+        }
+        // No tasks are left anywhere.
+        return false;
+    };
+
+    // Variables used for the error handling.
+    std::atomic<bool> failed{false};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+
+    // The function executed by all of the workers.
+    auto worker_loop = [&](unsigned int worker) {
+        std::size_t task = 0;
+        while ((!failed.load()) && next_task(worker, task)) {
+            try {
+                func(task, worker);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+                failed = true;
+            }
+        }
+    };
+
+    // Launch the helper threads, and take part in the processing.
+    std::vector<std::thread> threads;
+    threads.reserve(n_workers - 1);
+    for (unsigned int worker = 1; worker < n_workers; ++worker) {
+        threads.emplace_back(worker_loop, worker);
+    }
+    worker_loop(0u);
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    // Propagate the first error, if there was one.
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+}  // namespace traccc
@@ -0,0 +1,89 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2022 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+// Library include(s).
+#include "traccc/clusterization/cell_filtering.hpp"
+
+#include "traccc/clusterization/detail/measurement_creation_helper.hpp"
+#include "traccc/utils/work_stealing.hpp"
+
+// System include(s).
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace traccc {
+
+cell_filtering::cell_filtering(const pixel_mask& mask,
+                               const clusterization_config& config)
+    : m_mask(mask), m_config(config) {}
+
+cell_filtering::output_type cell_filtering::operator()(
+    cell_container_types::host&& cells) const {
+
+    // Filter the cells of the modules, biggest modules first.
+    std::vector<std::size_t> module_sizes(cells.size());
+    for (std::size_t i = 0; i < cells.size(); ++i) {
+        module_sizes[i] = cells.get_items()[i].size();
+    }
+
+    work_stealing_for_each(
+        largest_first(module_sizes), m_config.n_threads,
+        [&](std::size_t i, unsigned int) {
+            cell_module& module = cells.get_headers()[i];
+            auto& cells_per_module = cells.get_items()[i];
+            const pixel_mask::module_pixels* masked =
+                m_mask.find(module.module);
+
+            // Remove the cells not above threshold, or on a masked pixel.
+            const bool filter_below_threshold =
+                m_config.filter_below_threshold;
+            auto reject = [&module, masked,
+                           filter_below_threshold](const cell& c) {
+                return (filter_below_threshold &&
+                        (detail::signal_cell_modelling(c.activation, module) <=
+                         module.threshold)) ||
+                       ((masked != nullptr) &&
+                        pixel_mask::contains(*masked, c.channel0, c.channel1));
+            };
+            cells_per_module.erase(
+                std::remove_if(cells_per_module.begin(),
+                               cells_per_module.end(), reject),
+                cells_per_module.end());
+
+            // Update the ranges of the module.
+            module.range0[0] = std::numeric_limits<channel_id>::max();
+            module.range0[1] = 0;
+            module.range1[0] = std::numeric_limits<channel_id>::max();
+            module.range1[1] = 0;
+            for (const cell& c : cells_per_module) {
+                module.range0[0] = std::min(module.range0[0], c.channel0);
+                module.range0[1] = std::max(module.range0[1], c.channel0);
+                module.range1[0] = std::min(module.range1[0], c.channel1);
+                module.range1[1] = std::max(module.range1[1], c.channel1);
+            }
+        });
+
+    // Remove the modules that were left without cells.
+    std::size_t n_modules = 0;
+    for (std::size_t i = 0; i < cells.size(); ++i) {
+        if (cells.get_items()[i].empty()) {
+            continue;
+        }
+        if (n_modules != i) {
+            cells.get_headers()[n_modules] = cells.get_headers()[i];
+            cells.get_items()[n_modules] = std::move(cells.get_items()[i]);
+        }
+        ++n_modules;
+    }
+    cells.resize(n_modules);
+
+    return std::move(cells);
+}
+
+}  // namespace traccc
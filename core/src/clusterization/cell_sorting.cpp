@@ -0,0 +1,150 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2022 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+// Library include(s).
+#include "traccc/clusterization/cell_sorting.hpp"
+
+#include "traccc/utils/work_stealing.hpp"
+
+// System include(s).
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace traccc {
+
+namespace {
+
+/// Number of bits sorted on in one pass of the radix sort
+constexpr unsigned int radix_bits = 8;
+/// Number of buckets used in one pass of the radix sort
+constexpr std::size_t radix_buckets = 1u << radix_bits;
+
+/// Sort cells by one of their channels, with an LSD radix sort
+///
+/// Passes in which all cells have the same digit are skipped. The source and
+/// destination arrays are swapped after every (non-skipped) pass.
+///
+/// @param src The cells to sort
+/// @param dst Buffer of the same size as @c src
+/// @param n The number of cells
+/// @param key Function giving the (non-negative) sorting key of a cell
+/// @param max_key The largest key of all the cells
+///
+template <typename key_function_t>
+void radix_sort_pass(cell*& src, cell*& dst, std::size_t n,
+                     key_function_t key, channel_id max_key) {
+
+    for (unsigned int shift = 0;
+         (shift < sizeof(channel_id) * 8) && ((max_key >> shift) > 0);
+         shift += radix_bits) {
+
+        // Count the cells in every bucket.
+        std::array<std::size_t, radix_buckets> counts{};
+        for (std::size_t i = 0; i < n; ++i) {
+            ++counts[(key(src[i]) >> shift) & (radix_buckets - 1)];
+        }
+        if (std::find(counts.begin(), counts.end(), n) != counts.end()) {
+            continue;
+        }
+
+        // Turn the counts into the first index of every bucket.
+        std::size_t offset = 0;
+        for (std::size_t& count : counts) {
+            const std::size_t size = count;
+            count = offset;
+            offset += size;
+        }
+
+        // Scatter the cells into their buckets, keeping their order.
+        for (std::size_t i = 0; i < n; ++i) {
+            dst[counts[(key(src[i]) >> shift) & (radix_buckets - 1)]++] =
+                src[i];
+        }
+        std::swap(src, dst);
+    }
+}
+
+/// Sort the cells of one module into column major order
+///
+/// @param module The header of the module, its ranges get updated
+/// @param cells The cells of the module
+/// @param buffer Scratch memory, with space for as many cells as @c cells
+/// @param n The number of cells in the module
+///
+void sort_module(cell_module& module, cell* cells, cell* buffer,
+                 std::size_t n) {
+
+    if (n == 0) {
+        return;
+    }
+
+    // Find the ranges of the channels.
+    channel_id min0 = cells[0].channel0, max0 = cells[0].channel0;
+    channel_id min1 = cells[0].channel1, max1 = cells[0].channel1;
+    for (std::size_t i = 1; i < n; ++i) {
+        min0 = std::min(min0, cells[i].channel0);
+        max0 = std::max(max0, cells[i].channel0);
+        min1 = std::min(min1, cells[i].channel1);
+        max1 = std::max(max1, cells[i].channel1);
+    }
+    module.range0[0] = min0;
+    module.range0[1] = max0;
+    module.range1[0] = min1;
+    module.range1[1] = max1;
+
+    // Sort by the least significant key first, and then by the most
+    // significant one. Since every pass is stable, this results in a
+    // lexicographic ordering.
+    cell* src = cells;
+    cell* dst = buffer;
+    radix_sort_pass(
+        src, dst, n, [min0](const cell& c) { return c.channel0 - min0; },
+        max0 - min0);
+    radix_sort_pass(
+        src, dst, n, [min1](const cell& c) { return c.channel1 - min1; },
+        max1 - min1);
+
+    // Make sure that the result ends up in the module's own memory.
+    if (src != cells) {
+        std::copy(src, src + n, cells);
+    }
+}
+
+}  // namespace
+
+cell_sorting::cell_sorting(const clusterization_config& config)
+    : m_config(config) {}
+
+cell_sorting::output_type cell_sorting::operator()(
+    cell_container_types::host&& cells) const {
+
+    // Give every module its own range in the shared scratch buffer.
+    std::vector<std::size_t> module_sizes(cells.size());
+    std::vector<std::size_t> offsets(cells.size(), 0);
+    std::size_t total_cells = 0;
+    for (std::size_t i = 0; i < cells.size(); ++i) {
+        module_sizes[i] = cells.get_items()[i].size();
+        offsets[i] = total_cells;
+        total_cells += module_sizes[i];
+    }
+    std::vector<cell> buffer(total_cells);
+
+    // Sort the modules, biggest first.
+    work_stealing_for_each(
+        largest_first(module_sizes), m_config.n_threads,
+        [&](std::size_t i, unsigned int) {
+            sort_module(cells.get_headers()[i], cells.get_items()[i].data(),
+                        buffer.data() + offsets[i], module_sizes[i]);
+        });
+
+    return std::move(cells);
+}
+
+}  // namespace traccc
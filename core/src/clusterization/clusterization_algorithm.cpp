@@ -8,15 +8,72 @@
 // Library include(s).
 #include "traccc/clusterization/clusterization_algorithm.hpp"
 
+#include "traccc/clusterization/detail/measurement_creation_helper.hpp"
+
+// System include(s).
+#include <algorithm>
+#include <array>
+
 namespace traccc {
 
-clusterization_algorithm::clusterization_algorithm(vecmem::memory_resource& mr)
-    : m_cc(mr), m_mc(mr), m_mr(mr) {}
+clusterization_algorithm::clusterization_algorithm(
+    vecmem::memory_resource& mr, const clusterization_config& config)
+    : m_fc(mr, config), m_mr(mr) {}
 
 clusterization_algorithm::output_type clusterization_algorithm::operator()(
     const cell_container_types::host& cells) const {
 
-    return m_mc(cells, m_cc(cells));
+    return m_fc(cells);
+}
+
+clusterization_algorithm::output_type clusterization_algorithm::operator()(
+    const cell_container_types::host& cells, const geometry& geom,
+    const std::vector<region_of_interest>& rois) const {
+
+    // Select the modules overlapping with any of the regions of interest.
+    std::vector<std::size_t> modules;
+    for (std::size_t i = 0; i < cells.size(); ++i) {
+
+        const cell_module& module = cells.get_headers()[i];
+        const auto& cells_per_module = cells.get_items()[i];
+        if (cells_per_module.empty() || (!geom.contains(module.module))) {
+            continue;
+        }
+
+        // Find the channel range of the cells of the module.
+        cell min_cell = cells_per_module.front(), max_cell = min_cell;
+        for (const cell& c : cells_per_module) {
+            min_cell.channel0 = std::min(min_cell.channel0, c.channel0);
+            min_cell.channel1 = std::min(min_cell.channel1, c.channel1);
+            max_cell.channel0 = std::max(max_cell.channel0, c.channel0);
+            max_cell.channel1 = std::max(max_cell.channel1, c.channel1);
+        }
+
+        // Place the outer corners of the outermost cells.
+        const point2 min_local = detail::position_from_cell(min_cell, module);
+        const point2 max_local = detail::position_from_cell(max_cell, module);
+        const scalar half_pitch_x = 0.5f * module.pixel.pitch_x;
+        const scalar half_pitch_y = 0.5f * module.pixel.pitch_y;
+        const scalar x[2] = {min_local[0] - half_pitch_x,
+                             max_local[0] + half_pitch_x};
+        const scalar y[2] = {min_local[1] - half_pitch_y,
+                             max_local[1] + half_pitch_y};
+        const transform3& placement = geom[module.module];
+        const std::array<point3, 4> corners = {
+            placement.point_to_global(point3{x[0], y[0], 0.}),
+            placement.point_to_global(point3{x[1], y[0], 0.}),
+            placement.point_to_global(point3{x[0], y[1], 0.}),
+            placement.point_to_global(point3{x[1], y[1], 0.})};
+
+        if (std::any_of(rois.begin(), rois.end(),
+                        [&corners](const region_of_interest& roi) {
+                            return overlaps(roi, corners);
+                        })) {
+            modules.push_back(i);
+        }
+    }
+
+    return m_fc(cells, modules);
 }
 
 }  // namespace traccc
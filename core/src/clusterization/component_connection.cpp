@@ -8,56 +8,161 @@
 // Library include(s).
 #include "traccc/clusterization/component_connection.hpp"
 
-#include "traccc/clusterization/detail/sparse_ccl.hpp"
+#include "traccc/clusterization/detail/ccl_dispatch.hpp"
+#include "traccc/clusterization/detail/strip_ccl.hpp"
+#include "traccc/utils/work_stealing.hpp"
 
 // VecMem include(s).
 #include <vecmem/containers/device_vector.hpp>
 #include <vecmem/containers/vector.hpp>
 
+// System include(s).
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
 namespace traccc {
 
 component_connection::output_type component_connection::operator()(
     const cell_container_types::host& cells) const {
 
-    std::vector<std::size_t> num_clusters(cells.size(), 0);
-    std::vector<std::vector<unsigned int>> CCL_indices(cells.size());
+    // Find the clusters, as indices of their cells.
+    const cluster_index_types::host indices = cluster_indices(cells);
 
+    // Find the range of clusters of every module
+    std::vector<std::size_t> module_begin(cells.size() + 1, 0);
+    for (std::size_t module : indices.module_links) {
+        ++module_begin[module + 1];
+    }
     for (std::size_t i = 0; i < cells.size(); i++) {
-        const auto& cells_per_module = cells.get_items()[i];
-
-        CCL_indices[i] = std::vector<unsigned int>(cells_per_module.size());
-
-        // Run SparseCCL to fill CCL indices
-        num_clusters[i] = detail::sparse_ccl(cells_per_module, CCL_indices[i]);
+        module_begin[i + 1] += module_begin[i];
     }
 
-    // Get total number of clusters
-    const std::size_t N =
-        std::accumulate(num_clusters.begin(), num_clusters.end(), 0);
-
     // Create the result container.
-    output_type result(N, &(m_mr.get()));
+    output_type result(indices.size(), &(m_mr.get()));
 
-    std::size_t stack = 0;
+    // Copy the cells of the clusters. Every module fills a separate range of
+    // the result, so this can be done in parallel.
+    std::vector<std::size_t> module_sizes(cells.size());
     for (std::size_t i = 0; i < cells.size(); i++) {
+        module_sizes[i] = cells.get_items()[i].size();
+    }
+    work_stealing_for_each(
+        largest_first(module_sizes), m_config.n_threads,
+        [&](std::size_t i, unsigned int) {
+            for (std::size_t j = module_begin[i]; j < module_begin[i + 1];
+                 j++) {
+                result.get_headers()[j] = i;
+                const auto cluster = indices.cells(cells, j);
+                auto& cluster_cells = result.get_items()[j];
+                cluster_cells.reserve(cluster.size());
+                for (const cell& c : cluster) {
+                    cluster_cells.push_back(c);
+                }
+            }
+        });
 
-        auto& cells_per_module = cells.get_items()[i];
-
-        // Fill the module link
-        std::fill(result.get_headers().begin() + stack,
-                  result.get_headers().begin() + stack + num_clusters[i], i);
+    return result;
+}
 
-        // Full the cluster cells
-        for (std::size_t j = 0; j < CCL_indices[i].size(); j++) {
+cluster_index_types::host component_connection::cluster_indices(
+    const cell_container_types::host& cells) const {
 
-            auto cindex = static_cast<unsigned int>(CCL_indices[i][j] - 1);
+    std::vector<std::size_t> num_clusters(cells.size(), 0);
+    std::vector<std::vector<unsigned int>> CCL_indices(cells.size());
 
-            result.get_items()[stack + cindex].push_back(cells_per_module[j]);
+    // Schedule the modules with the most cells first
+    std::vector<std::size_t> module_sizes(cells.size());
+    for (std::size_t i = 0; i < cells.size(); i++) {
+        module_sizes[i] = cells.get_items()[i].size();
+    }
+    const std::vector<std::size_t> schedule = largest_first(module_sizes);
+
+    // Label the biggest modules one by one, each of them on all threads
+    std::vector<std::size_t> small_modules;
+    detail::strip_ccl_scratch strip_scratch;
+    for (std::size_t i : schedule) {
+        if (detail::use_strip_ccl(cells.get_headers()[i], module_sizes[i],
+                                  m_config) == false) {
+            small_modules.push_back(i);
+            continue;
         }
+        CCL_indices[i] = std::vector<unsigned int>(module_sizes[i]);
+        num_clusters[i] = detail::strip_ccl(
+            cells.get_items()[i], CCL_indices[i], m_config, strip_scratch);
+    }
 
-        stack += num_clusters[i];
+    std::vector<detail::ccl_scratch> scratch(std::max(m_config.n_threads, 1u));
+
+    work_stealing_for_each(
+        small_modules, m_config.n_threads,
+        [&](std::size_t i, unsigned int worker) {
+            const auto& cells_per_module = cells.get_items()[i];
+
+            CCL_indices[i] = std::vector<unsigned int>(cells_per_module.size());
+
+            // Run the CCL engine of the module to fill CCL indices
+            num_clusters[i] =
+                detail::run_ccl(cells.get_headers()[i], cells_per_module,
+                                CCL_indices[i], m_config, scratch[worker]);
+        });
+
+    // Get the index of the first cluster, and of the first cell of every
+    // module. As every cell belongs to exactly one cluster, the clusters of
+    // a module take up the same range of cell indices as its cells. (The
+    // cell offsets are stored as unsigned int, as are the cell indices.)
+    std::vector<std::size_t> cluster_offsets(cells.size(), 0);
+    std::vector<unsigned int> cell_offsets(cells.size(), 0);
+    for (std::size_t i = 1; i < cells.size(); i++) {
+        cluster_offsets[i] = cluster_offsets[i - 1] + num_clusters[i - 1];
+        cell_offsets[i] = cell_offsets[i - 1] +
+                          static_cast<unsigned int>(module_sizes[i - 1]);
     }
 
+    // Get total number of clusters and cells
+    const std::size_t N = std::accumulate(num_clusters.begin(),
+                                          num_clusters.end(), std::size_t(0));
+    const std::size_t n_cells = std::accumulate(
+        module_sizes.begin(), module_sizes.end(), std::size_t(0));
+
+    // Create the result object.
+    cluster_index_types::host result(&(m_mr.get()));
+    result.module_links.resize(N);
+    result.cell_offsets.resize(N + 1);
+    result.cell_offsets[N] = static_cast<unsigned int>(n_cells);
+    result.cell_indices.resize(n_cells);
+
+    // Every module fills a separate range of the result, so this can also be
+    // done in parallel
+    work_stealing_for_each(
+        schedule, m_config.n_threads, [&](std::size_t i, unsigned int) {
+            const std::size_t stack = cluster_offsets[i];
+
+            // Fill the module link
+            std::fill(result.module_links.begin() + stack,
+                      result.module_links.begin() + stack + num_clusters[i],
+                      i);
+
+            // Find the offsets of the clusters, from their sizes
+            std::vector<unsigned int> cursor(num_clusters[i], 0);
+            for (unsigned int label : CCL_indices[i]) {
+                ++cursor[label - 1];
+            }
+            unsigned int offset = cell_offsets[i];
+            for (std::size_t j = 0; j < num_clusters[i]; j++) {
+                result.cell_offsets[stack + j] = offset;
+                offset += cursor[j];
+                cursor[j] = result.cell_offsets[stack + j];
+            }
+
+            // Fill the cell indices, keeping the order of the cells inside of
+            // every cluster
+            for (std::size_t j = 0; j < CCL_indices[i].size(); j++) {
+                result.cell_indices[cursor[CCL_indices[i][j] - 1]++] =
+                    static_cast<unsigned int>(j);
+            }
+        });
+
     return result;
 }
 
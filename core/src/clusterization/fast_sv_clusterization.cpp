@@ -0,0 +1,400 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2022 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+// Library include(s).
+#include "traccc/clusterization/fast_sv_clusterization.hpp"
+
+#include "traccc/clusterization/detail/measurement_creation_helper.hpp"
+#include "traccc/clusterization/detail/sparse_ccl.hpp"
+#include "traccc/definitions/primitives.hpp"
+#include "traccc/edm/cluster.hpp"
+#include "traccc/utils/work_stealing.hpp"
+
+// System include(s).
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+namespace traccc {
+
+namespace {
+
+/// Structure that defines the start point of a partition and its size
+struct ccl_partition {
+    std::size_t start;
+    std::size_t size;
+};
+
+/// Flattened data arrays of all the cells of an event
+struct cell_arrays {
+    std::vector<channel_id> channel0;
+    std::vector<channel_id> channel1;
+    /// Index of the module of the cell, in the input container
+    std::vector<unsigned int> module;
+    /// Index of the cell inside of its module
+    std::vector<unsigned int> index;
+};
+
+/// Measurements found in one partition
+struct partition_result {
+    std::size_t n_clusters = 0;
+    /// Number of clusters of the consecutive modules of the partition, as
+    /// (module index, number of clusters) pairs
+    std::vector<std::pair<unsigned int, std::size_t>> module_clusters;
+    /// Index of the module of each measurement, in the input container
+    std::vector<unsigned int> modules;
+    std::vector<measurement> measurements;
+};
+
+/// Scratch memory re-used by a worker thread for all of its partitions
+struct worker_scratch {
+    /// Adjacency lists of the cells, in compressed row storage
+    std::vector<unsigned int> adj_offsets;
+    std::vector<unsigned int> adj_indices;
+    /// Parent and grandparent arrays of FastSV
+    std::vector<unsigned int> f;
+    std::vector<unsigned int> gf;
+    /// Smallest grandparent in the neighbourhood of every cell
+    std::vector<unsigned int> hook;
+    /// Offset of the cells of every cluster in @c cell_indices
+    std::vector<unsigned int> cluster_offsets;
+    /// Indices of the cells inside of their modules, grouped by cluster
+    std::vector<unsigned int> cell_indices;
+    /// Index of the module of every cluster, in the input container
+    std::vector<unsigned int> cluster_modules;
+};
+
+/// Check if two cells are considered close enough to be part of the same
+/// cluster
+inline bool is_adjacent(channel_id ac0, channel_id ac1, channel_id bc0,
+                        channel_id bc1) {
+    const channel_id p0 = (ac0 - bc0);
+    const channel_id p1 = (ac1 - bc1);
+
+    return p0 * p0 <= 1 && p1 * p1 <= 1;
+}
+
+/// Split the cells of an event into partitions
+///
+/// A new partition is started at an empty row of a module, or at the start
+/// of a module, once the current partition has at least @c min_size cells.
+///
+std::vector<ccl_partition> partition(const cell_container_types::host& data,
+                                     std::size_t min_size) {
+
+    std::vector<ccl_partition> partitions;
+    std::size_t index = 0;
+    std::size_t size = 0;
+
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        channel_id last_mid = 0;
+
+        for (const cell& c : data.get_items()[i]) {
+            if (c.channel1 > last_mid + 1 && size >= min_size) {
+                partitions.push_back({index, size});
+                index += size;
+                size = 0;
+            }
+            last_mid = c.channel1;
+            size += 1;
+        }
+
+        if (size >= min_size) {
+            partitions.push_back({index, size});
+            index += size;
+            size = 0;
+        }
+    }
+
+    if (size > 0) {
+        partitions.push_back({index, size});
+    }
+
+    return partitions;
+}
+
+/// Collect the adjacent cells of every cell of a partition
+///
+/// This translates the sparse CCL problem into a graph CCL problem. Since
+/// the cells are sorted by channel1 inside of every module, only a small
+/// window around each cell needs to be checked.
+///
+void build_adjacency(const cell_arrays& cells, const ccl_partition& part,
+                     worker_scratch& ws) {
+
+    const channel_id* c0 = cells.channel0.data() + part.start;
+    const channel_id* c1 = cells.channel1.data() + part.start;
+    const unsigned int* mod = cells.module.data() + part.start;
+    const unsigned int n = static_cast<unsigned int>(part.size);
+
+    ws.adj_offsets.resize(n + 1);
+    ws.adj_indices.clear();
+
+    for (unsigned int i = 0; i < n; ++i) {
+        ws.adj_offsets[i] = ws.adj_indices.size();
+
+        // Find the window of cells in the same module, in the neighbouring
+        // columns.
+        unsigned int begin = i;
+        while (begin > 0 && c1[begin - 1] + 1 >= c1[i] &&
+               mod[begin - 1] == mod[i]) {
+            --begin;
+        }
+        unsigned int end = i + 1;
+        while (end < n && c1[end] <= c1[i] + 1 && mod[end] == mod[i]) {
+            ++end;
+        }
+
+        // Collect the adjacent cells in the window.
+        for (unsigned int j = begin; j < end; ++j) {
+            if (j != i && is_adjacent(c0[i], c1[i], c0[j], c1[j])) {
+                ws.adj_indices.push_back(j);
+            }
+        }
+    }
+    ws.adj_offsets[n] = ws.adj_indices.size();
+}
+
+/// Set the grandparent of every cell from the parent array
+///
+/// @return @c true if any of the grandparents changed
+///
+bool update_grandparents(unsigned int n, const unsigned int* __restrict f,
+                         unsigned int* __restrict gf) {
+
+    unsigned int n_changed = 0;
+    for (unsigned int i = 0; i < n; ++i) {
+        const unsigned int g = f[f[i]];
+        n_changed += (g != gf[i]);
+        gf[i] = g;
+    }
+    return (n_changed != 0);
+}
+
+/// FastSV algorithm with a mix of stochastic and aggressive hooking,
+/// followed by shortcutting
+///
+/// This is the host version of @c fast_sv_1 from the CUDA implementation,
+/// following Algorithm 3 of
+/// https://www.sciencedirect.com/science/article/pii/S0743731520302689
+///
+/// Where the CUDA version lets the threads of a block update the parent
+/// array concurrently, every iteration is split here into passes without
+/// write conflicts between the cells: the hooking candidates are gathered
+/// first, and only then applied. Apart from the stochastic hooking (which
+/// writes to the parents of the cells, and so remains a scalar loop) the
+/// passes get vectorized by the compiler, with the gathers of the
+/// neighbourhood minimum and of the grandparents making use of gather
+/// instructions where available (AVX2).
+///
+/// Once it converged, @c gf holds the smallest cell index of its cluster
+/// for every cell.
+///
+void fast_sv(unsigned int n, worker_scratch& ws) {
+
+    unsigned int* f = ws.f.data();
+    unsigned int* gf = ws.gf.data();
+    unsigned int* hook = ws.hook.data();
+    const unsigned int* adj_offsets = ws.adj_offsets.data();
+    const unsigned int* adj_indices = ws.adj_indices.data();
+
+    std::iota(f, f + n, 0u);
+    std::iota(gf, gf + n, 0u);
+
+    bool gf_changed = false;
+    do {
+        // Find the smallest grandparent in the neighbourhood of every cell.
+        for (unsigned int i = 0; i < n; ++i) {
+            unsigned int q = gf[i];
+            for (unsigned int k = adj_offsets[i]; k < adj_offsets[i + 1];
+                 ++k) {
+                q = std::min(q, gf[adj_indices[k]]);
+            }
+            hook[i] = q;
+        }
+
+        // Stochastic hooking: hook the parent of every cell to the smallest
+        // grandparent in its neighbourhood. The result does not depend on
+        // the order of the cells, as only the minimum is kept.
+        for (unsigned int i = 0; i < n; ++i) {
+            f[f[i]] = std::min(f[f[i]], hook[i]);
+        }
+
+        // Aggressive hooking and shortcutting. (hook[i] <= gf[i], so this
+        // also takes care of the shortcutting.)
+        for (unsigned int i = 0; i < n; ++i) {
+            f[i] = std::min(f[i], hook[i]);
+        }
+
+        // Update the grandparents for the next iteration.
+        gf_changed = update_grandparents(n, f, gf);
+
+    } while (gf_changed);
+}
+
+}  // namespace
+
+fast_sv_clusterization::fast_sv_clusterization(
+    vecmem::memory_resource& mr, const clusterization_config& config)
+    : m_mr(mr), m_config(config) {}
+
+fast_sv_clusterization::output_type fast_sv_clusterization::operator()(
+    const cell_container_types::host& data) const {
+
+    // Flatten the data, to access the cells of the partitions contiguously.
+    std::size_t total_cells = 0;
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        total_cells += data.get_items()[i].size();
+    }
+    cell_arrays cells;
+    cells.channel0.reserve(total_cells);
+    cells.channel1.reserve(total_cells);
+    cells.module.reserve(total_cells);
+    cells.index.reserve(total_cells);
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        const auto& cells_per_module = data.get_items()[i];
+        for (std::size_t j = 0; j < cells_per_module.size(); ++j) {
+            cells.channel0.push_back(cells_per_module[j].channel0);
+            cells.channel1.push_back(cells_per_module[j].channel1);
+            cells.module.push_back(static_cast<unsigned int>(i));
+            cells.index.push_back(static_cast<unsigned int>(j));
+        }
+    }
+
+    // Separate the problem into independent partitions.
+    const std::vector<ccl_partition> partitions =
+        partition(data, min_cells_per_partition);
+
+    // Process the partitions, biggest first, on all available threads.
+    std::vector<std::size_t> partition_sizes(partitions.size());
+    for (std::size_t i = 0; i < partitions.size(); ++i) {
+        partition_sizes[i] = partitions[i].size;
+    }
+    std::vector<partition_result> results(partitions.size());
+    std::vector<worker_scratch> scratch(std::max(m_config.n_threads, 1u));
+
+    work_stealing_for_each(
+        largest_first(partition_sizes), m_config.n_threads,
+        [&](std::size_t p, unsigned int worker) {
+            const ccl_partition& part = partitions[p];
+            const unsigned int n = static_cast<unsigned int>(part.size);
+            worker_scratch& ws = scratch[worker];
+            partition_result& res = results[p];
+
+            // Find the clusters of the partition.
+            build_adjacency(cells, part, ws);
+            ws.f.resize(n);
+            ws.gf.resize(n);
+            ws.hook.resize(n);
+            fast_sv(n, ws);
+            res.n_clusters = detail::transitive_closure(ws.gf, n);
+
+            // Group the cells by cluster, keeping their order. This moves
+            // the offset of every cluster to the offset of the next one.
+            auto& offsets = ws.cluster_offsets;
+            offsets.assign(res.n_clusters + 1, 0);
+            for (unsigned int i = 0; i < n; ++i) {
+                ++offsets[ws.gf[i]];
+            }
+            for (std::size_t i = 1; i <= res.n_clusters; ++i) {
+                offsets[i] += offsets[i - 1];
+            }
+            ws.cell_indices.resize(n);
+            ws.cluster_modules.resize(res.n_clusters);
+            for (unsigned int i = 0; i < n; ++i) {
+                ws.cell_indices[offsets[ws.gf[i] - 1]++] =
+                    cells.index[part.start + i];
+                ws.cluster_modules[ws.gf[i] - 1] = cells.module[part.start + i];
+            }
+
+            // Create the measurements of the partition, just like
+            // measurement_creation does.
+            res.modules.clear();
+            res.measurements.clear();
+            res.module_clusters.clear();
+            unsigned int begin = 0;
+            for (std::size_t i = 0; i < res.n_clusters; ++i) {
+                const unsigned int end = offsets[i];
+                const unsigned int module = ws.cluster_modules[i];
+                if (res.module_clusters.empty() ||
+                    (res.module_clusters.back().first != module)) {
+                    res.module_clusters.push_back({module, 0});
+                }
+                ++res.module_clusters.back().second;
+                const cell_module& header = data.get_headers()[module];
+                const cluster_cells<cell_collection_types::host,
+                                    const unsigned int>
+                    cluster(data.get_items()[module],
+                            ws.cell_indices.data() + begin, end - begin);
+                begin = end;
+
+                scalar totalWeight = 0.;
+                point2 mean{0., 0.}, var{0., 0.};
+                detail::calc_measurement_properties(cluster, header, mean, var,
+                                                    totalWeight);
+                if (totalWeight > 0.) {
+                    res.modules.push_back(module);
+                    res.measurements.push_back(detail::create_measurement(
+                        mean, var, totalWeight, header, i));
+                }
+            }
+        });
+
+    // Set up one result entry for every module with cells.
+    std::vector<std::size_t> module_entries(data.size(), 0);
+    std::size_t n_entries = 0;
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        module_entries[i] = n_entries;
+        if (data.get_items()[i].empty() == false) {
+            ++n_entries;
+        }
+    }
+    output_type result(n_entries, &(m_mr.get()));
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        if (data.get_items()[i].empty() == false) {
+            result.get_headers()[module_entries[i]] = data.get_headers()[i];
+        }
+    }
+
+    // The clusters are numbered in the order of their modules. Find the
+    // (global) index of the first cluster of the event of every module, so
+    // that the cluster links count from zero for every event.
+    std::vector<std::size_t> module_clusters(data.size(), 0);
+    for (const partition_result& res : results) {
+        for (const auto& [module, n_clusters] : res.module_clusters) {
+            module_clusters[module] += n_clusters;
+        }
+    }
+    std::vector<std::size_t> event_first_cluster(data.size(), 0);
+    std::size_t cluster_offset = 0;
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        if ((i > 0) &&
+            (data.get_headers()[i].event == data.get_headers()[i - 1].event)) {
+            event_first_cluster[i] = event_first_cluster[i - 1];
+        } else {
+            event_first_cluster[i] = cluster_offset;
+        }
+        cluster_offset += module_clusters[i];
+    }
+
+    // Copy the measurements into the result, in the order of the partitions,
+    // making the cluster links count the clusters of their event.
+    cluster_offset = 0;
+    for (partition_result& res : results) {
+        for (std::size_t i = 0; i < res.measurements.size(); ++i) {
+            measurement& m = res.measurements[i];
+            m.cluster_link += cluster_offset;
+            m.cluster_link -= event_first_cluster[res.modules[i]];
+            result.get_items()[module_entries[res.modules[i]]].push_back(m);
+        }
+        cluster_offset += res.n_clusters;
+    }
+
+    return result;
+}
+
+}  // namespace traccc
@@ -0,0 +1,98 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2022 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+// Library include(s).
+#include "traccc/clusterization/fused_clusterization.hpp"
+
+#include "traccc/clusterization/detail/module_clusterization.hpp"
+#include "traccc/clusterization/detail/strip_ccl.hpp"
+#include "traccc/utils/work_stealing.hpp"
+
+namespace traccc {
+
+fused_clusterization::fused_clusterization(vecmem::memory_resource& mr,
+                                           const clusterization_config& config)
+    : m_mr(mr), m_config(config) {}
+
+fused_clusterization::output_type fused_clusterization::operator()(
+    const cell_container_types::host& cells) const {
+
+    // Only modules with cells produce an entry in the output.
+    std::vector<std::size_t> modules;
+    modules.reserve(cells.size());
+    for (std::size_t i = 0; i < cells.size(); ++i) {
+        if (cells.get_items()[i].empty() == false) {
+            modules.push_back(i);
+        }
+    }
+    return (*this)(cells, modules);
+}
+
+fused_clusterization::output_type fused_clusterization::operator()(
+    const cell_container_types::host& cells,
+    const std::vector<std::size_t>& modules) const {
+
+    // Create the result object, with one entry per selected module.
+    output_type result(modules.size(), &(m_mr.get()));
+    std::vector<std::size_t> num_clusters(modules.size(), 0);
+
+    // Label the biggest modules one by one, each of them on all threads.
+    // Schedule the rest of the modules with the most cells first.
+    std::vector<std::size_t> module_sizes(modules.size());
+    for (std::size_t i = 0; i < modules.size(); ++i) {
+        module_sizes[i] = cells.get_items()[modules[i]].size();
+    }
+    std::vector<std::size_t> schedule;
+    std::vector<detail::module_clusterization_scratch> scratch(
+        std::max(m_config.n_threads, 1u));
+    detail::strip_ccl_scratch strip_scratch;
+    for (std::size_t i : largest_first(module_sizes)) {
+        if (detail::use_strip_ccl(cells.get_headers()[modules[i]],
+                                  module_sizes[i], m_config) == false) {
+            schedule.push_back(i);
+            continue;
+        }
+        const auto& module = cells.get_headers()[modules[i]];
+        const auto& cells_per_module = cells.get_items()[modules[i]];
+        result.get_headers()[i] = module;
+        scratch[0].labels.resize(cells_per_module.size());
+        num_clusters[i] = detail::strip_ccl(
+            cells_per_module, scratch[0].labels, m_config, strip_scratch);
+        detail::create_module_measurements(module, cells_per_module,
+                                           num_clusters[i], scratch[0], 0,
+                                           result.get_items()[i]);
+    }
+
+    // Every module fills a separate entry of the result, so the modules can
+    // be processed in parallel. The cluster links are made global after all
+    // modules are done.
+    work_stealing_for_each(
+        schedule, m_config.n_threads, [&](std::size_t i, unsigned int worker) {
+            result.get_headers()[i] = cells.get_headers()[modules[i]];
+            num_clusters[i] = detail::clusterize_module(
+                cells.get_headers()[modules[i]], cells.get_items()[modules[i]],
+                m_config, scratch[worker], 0, result.get_items()[i]);
+        });
+
+    // Offset the cluster links by the number of clusters in the previous
+    // modules of the same event
+    std::size_t cluster_offset = 0;
+    for (std::size_t i = 0; i < modules.size(); ++i) {
+        if ((i > 0) && (result.get_headers()[i].event !=
+                        result.get_headers()[i - 1].event)) {
+            cluster_offset = 0;
+        }
+        for (measurement& m : result.get_items()[i]) {
+            m.cluster_link += cluster_offset;
+        }
+        cluster_offset += num_clusters[i];
+    }
+
+    return result;
+}
+
+}  // namespace traccc
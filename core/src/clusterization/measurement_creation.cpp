@@ -10,54 +10,114 @@
 
 #include "traccc/clusterization/detail/measurement_creation_helper.hpp"
 #include "traccc/definitions/primitives.hpp"
+#include "traccc/utils/work_stealing.hpp"
+
+// System include(s).
+#include <cassert>
+#include <vector>
 
 namespace traccc {
 
-measurement_creation::measurement_creation(vecmem::memory_resource &mr)
-    : m_mr(mr) {}
+measurement_creation::measurement_creation(
+    vecmem::memory_resource &mr, const clusterization_config &config)
+    : m_mr(mr), m_config(config) {}
 
-measurement_creation::output_type measurement_creation::operator()(
-    const cell_container_types::host &cells,
-    const cluster_container_types::host &clusters) const {
+namespace {
+
+/// Create the measurements of clusters of any kind
+///
+/// @param cells are the cells that the clusters were found in
+/// @param n_clusters_total is the number of clusters
+/// @param module_link returns the module link of cluster @c i
+/// @param get_cluster returns the cells of cluster @c i
+/// @param mr is the memory resource to create the result with
+/// @param config is the clusterization configuration
+///
+template <typename module_link_t, typename get_cluster_t>
+measurement_container_types::host create_measurements(
+    const cell_container_types::host &cells, std::size_t n_clusters_total,
+    module_link_t module_link, get_cluster_t get_cluster,
+    vecmem::memory_resource &mr, const clusterization_config &config) {
 
-    // Create the result object.
-    output_type result(&(m_mr.get()));
-    result.reserve(cells.size());
-
-    // Process the clusters one-by-one.
-    for (std::size_t i = 0; i < clusters.size(); ++i) {
-        // To calculate the mean and variance with high numerical stability
-        // we use a weighted variant of Welford's algorithm. This is a
-        // single-pass online algorithm that works well for large numbers
-        // of samples, as well as samples with very high values.
-        //
-        // To learn more about this algorithm please refer to:
-        // [1] https://doi.org/10.1080/00401706.1962.10490022
-        // [2] The Art of Computer Programming, Donald E. Knuth, second
-        //     edition, chapter 4.2.2.
-
-        // Get the cell module
-        const auto &module_link = clusters.at(i).header;
-        const auto &module = cells.at(module_link).header;
-
-        if (result.size() == 0 ||
-            result.get_headers().back().module != module.module) {
-            result.push_back(cell_module(module),
-                             measurement_collection_types::host(&(m_mr.get())));
+    // First pass: find the ranges of clusters belonging to the same module.
+    // Every such range gets one entry in the result.
+    std::vector<std::size_t> entry_begin;
+    for (std::size_t i = 0; i < n_clusters_total; ++i) {
+        if ((i == 0) || (module_link(i) != module_link(i - 1))) {
+            entry_begin.push_back(i);
         }
+    }
+    const std::size_t n_entries = entry_begin.size();
+    entry_begin.push_back(n_clusters_total);
 
-        // Get the cluster.
-        cluster_container_types::host::item_vector::const_reference cluster =
-            clusters.at(i).items;
+    // Create the result object, with every measurement collection allocated
+    // for all the clusters of its module in one go.
+    measurement_container_types::host result(n_entries, &mr);
+    std::vector<std::size_t> n_clusters(n_entries);
+    for (std::size_t e = 0; e < n_entries; ++e) {
+        n_clusters[e] = entry_begin[e + 1] - entry_begin[e];
+        result.get_headers()[e] = cells.at(module_link(entry_begin[e])).header;
+        result.get_items()[e].resize(n_clusters[e]);
+    }
 
-        // A security check.
-        assert(cluster.empty() == false);
+    // Second pass: fill the measurements of the modules, in parallel.
+    work_stealing_for_each(
+        largest_first(n_clusters), config.n_threads,
+        [&](std::size_t e, unsigned int) {
+            const cell_module &module = result.get_headers()[e];
+            auto &measurements = result.get_items()[e];
 
-        // Fill measurement from cluster
-        detail::fill_measurement(result, cluster, module, module_link, i);
-    }
+            std::size_t n_measurements = 0;
+            for (std::size_t i = entry_begin[e]; i < entry_begin[e + 1];
+                 ++i) {
+                // Get the cluster.
+                const auto &cluster = get_cluster(i);
+
+                // A security check.
+                assert(cluster.empty() == false);
+
+                // Calculate the cluster properties, with the function best
+                // suited for the size of the cluster.
+                scalar totalWeight = 0.;
+                point2 mean{0., 0.}, var{0., 0.};
+                detail::calc_measurement_properties(cluster, module, mean, var,
+                                                    totalWeight);
+                if (totalWeight > 0.) {
+                    measurements[n_measurements++] = detail::create_measurement(
+                        mean, var, totalWeight, module, i);
+                }
+            }
+
+            // Drop the slots of the clusters without any signal. (This does
+            // not re-allocate the collection.)
+            measurements.resize(n_measurements);
+        });
 
     return result;
 }
 
+}  // namespace
+
+measurement_creation::output_type measurement_creation::operator()(
+    const cell_container_types::host &cells,
+    const cluster_container_types::host &clusters) const {
+
+    return create_measurements(
+        cells, clusters.size(),
+        [&](std::size_t i) { return clusters.get_headers()[i]; },
+        [&](std::size_t i) -> const auto & { return clusters.get_items()[i]; },
+        m_mr.get(), m_config);
+}
+
+measurement_creation::output_type measurement_creation::operator()(
+    const cell_container_types::host &cells,
+    const cluster_index_types::host &clusters) const {
+
+    return create_measurements(
+        cells, clusters.size(),
+        [&](std::size_t i) { return clusters.module_links[i]; },
+        [&](std::size_t i) { return clusters.cells(cells, i); }, m_mr.get(),
+        m_config);
+}
+
 }  // namespace traccc
@@ -0,0 +1,34 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2022 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+// Library include(s).
+#include "traccc/clusterization/streaming_clusterization.hpp"
+
+namespace traccc {
+
+streaming_clusterization::streaming_clusterization(
+    vecmem::memory_resource& mr, const clusterization_config& config)
+    : m_mr(mr), m_config(config) {}
+
+measurement_collection_types::host streaming_clusterization::operator()(
+    const cell_module& module, const cell_collection_types::host& cells) {
+
+    measurement_collection_types::host measurements(&(m_mr.get()));
+    m_n_clusters += detail::clusterize_module(
+        module, cells, m_config, m_scratch, m_n_clusters, measurements);
+    return measurements;
+}
+
+std::size_t streaming_clusterization::n_clusters() const {
+    return m_n_clusters;
+}
+
+void streaming_clusterization::reset() {
+    m_n_clusters = 0;
+}
+
+}  // namespace traccc
@@ -10,6 +10,12 @@
 
 #include "traccc/seeding/seed_selecting_helper.hpp"
 
+// System include(s).
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <utility>
+
 namespace traccc {
 
 seed_filtering::seed_filtering(const seedfilter_config& config)
@@ -20,7 +26,18 @@ void seed_filtering::operator()(
     triplet_collection_types::host& triplets,
     seed_collection_types::host& seeds) const {
 
-    seed_collection_types::host seeds_per_spM;
+    seed_filtering_scratch scratch;
+    this->operator()(sp_container, g2, triplets, seeds, scratch);
+}
+
+void seed_filtering::operator()(
+    const spacepoint_container_types::host& sp_container, const sp_grid& g2,
+    triplet_collection_types::host& triplets,
+    seed_collection_types::host& seeds,
+    seed_filtering_scratch& scratch) const {
+
+    auto& seeds_per_spM = scratch.seeds_per_spM;
+    seeds_per_spM.clear();
 
     for (triplet& triplet : triplets) {
         // bottom
@@ -47,44 +64,54 @@ void seed_filtering::operator()(
                                  triplet.weight, triplet.z_vertex});
     }
 
-    // sort seeds based on their weights
-    std::sort(seeds_per_spM.begin(), seeds_per_spM.end(),
-              [&](seed& seed1, seed& seed2) {
-                  if (seed1.weight != seed2.weight) {
-                      return seed1.weight > seed2.weight;
-                  } else {
-                      scalar seed1_sum = 0;
-                      scalar seed2_sum = 0;
-                      auto& spB1 = sp_container.at(seed1.spB_link);
-                      auto& spT1 = sp_container.at(seed1.spT_link);
-                      auto& spB2 = sp_container.at(seed2.spB_link);
-                      auto& spT2 = sp_container.at(seed2.spT_link);
-
-                      seed1_sum += pow(spB1.y(), 2) + pow(spB1.z(), 2);
-                      seed1_sum += pow(spT1.y(), 2) + pow(spT1.z(), 2);
-                      seed2_sum += pow(spB2.y(), 2) + pow(spB2.z(), 2);
-                      seed2_sum += pow(spT2.y(), 2) + pow(spT2.z(), 2);
-
-                      return seed1_sum > seed2_sum;
-                  }
-              });
-
-    seed_collection_types::host new_seeds;
-    if (seeds_per_spM.size() > 1) {
-        new_seeds.push_back(seeds_per_spM[0]);
-
-        size_t itLength = std::min(seeds_per_spM.size(),
-                                   m_filter_config.max_triplets_per_spM);
+    // the key for ordering seeds of equal weight, computed once per seed
+    const std::size_t n_seeds = seeds_per_spM.size();
+    auto& yz_sums = scratch.yz_sums;
+    yz_sums.resize(n_seeds);
+    for (std::size_t i = 0; i < n_seeds; ++i) {
+        auto& spB = sp_container.at(seeds_per_spM[i].spB_link);
+        auto& spT = sp_container.at(seeds_per_spM[i].spT_link);
+
+        scalar sum = 0;
+        sum += pow(spB.y(), 2) + pow(spB.z(), 2);
+        sum += pow(spT.y(), 2) + pow(spT.z(), 2);
+        yz_sums[i] = sum;
+    }
+
+    // only the best max_triplets_per_spM seeds (but at least one) are
+    // considered, so only those are sorted based on their weights
+    const std::size_t n_sorted =
+        (n_seeds > 1)
+            ? std::max<std::size_t>(
+                  std::min(n_seeds, m_filter_config.max_triplets_per_spM), 1)
+            : n_seeds;
+    auto& order = scratch.order;
+    order.resize(n_seeds);
+    std::iota(order.begin(), order.end(), 0u);
+    std::partial_sort(order.begin(), order.begin() + n_sorted, order.end(),
+                      [&](unsigned int i1, unsigned int i2) {
+                          const seed& seed1 = seeds_per_spM[i1];
+                          const seed& seed2 = seeds_per_spM[i2];
+                          if (seed1.weight != seed2.weight) {
+                              return seed1.weight > seed2.weight;
+                          }
+                          if (yz_sums[i1] != yz_sums[i2]) {
+                              return yz_sums[i1] > yz_sums[i2];
+                          }
+                          return i1 < i2;
+                      });
+
+    auto& new_seeds = scratch.new_seeds;
+    new_seeds.clear();
+    for (std::size_t i = 0; i < n_sorted; i++) {
+        const seed& s = seeds_per_spM[order[i]];
         // don't cut first element
-        for (size_t i = 1; i < itLength; i++) {
-            if (seed_selecting_helper::cut_per_middle_sp(
-                    m_filter_config, sp_container, seeds_per_spM[i],
-                    seeds_per_spM[i].weight)) {
-                new_seeds.push_back(std::move(seeds_per_spM[i]));
-            }
+        if ((i == 0) || seed_selecting_helper::cut_per_middle_sp(
+                            m_filter_config, sp_container, s, s.weight)) {
+            new_seeds.push_back(s);
         }
-        seeds_per_spM = std::move(new_seeds);
     }
+    std::swap(seeds_per_spM, new_seeds);
 
     unsigned int maxSeeds = seeds_per_spM.size();
 
@@ -8,64 +8,136 @@
 // Library include(s).
 #include "traccc/seeding/seed_finding.hpp"
 
+#include "traccc/utils/work_stealing.hpp"
+
+// System include(s).
+#include <algorithm>
+#include <vector>
+
 namespace traccc {
 
 seed_finding::seed_finding(const seedfinder_config& finder_config,
-                           const seedfilter_config& filter_config)
+                           const seedfilter_config& filter_config,
+                           unsigned int n_threads)
     : m_doublet_finding(finder_config.toInternalUnits()),
       m_triplet_finding(finder_config.toInternalUnits()),
-      m_seed_filtering(filter_config.toInternalUnits()) {}
+      m_seed_filtering(filter_config.toInternalUnits()),
+      m_n_threads(n_threads) {}
 
 seed_finding::output_type seed_finding::operator()(
     const spacepoint_container_types::host& sp_container,
     const sp_grid& g2) const {
 
-    // Run the algorithm
-    output_type seeds;
+    return find_all_seeds(sp_container, g2, nullptr);
+}
 
-    const bool bottom = true;
-    const bool top = false;
+seed_finding::output_type seed_finding::operator()(
+    const spacepoint_container_types::host& sp_container, const sp_grid& g2,
+    const sp_grid_soa_types::host& soa) const {
 
+    return find_all_seeds(sp_container, g2, &soa);
+}
+
+seed_finding::output_type seed_finding::find_all_seeds(
+    const spacepoint_container_types::host& sp_container, const sp_grid& g2,
+    const sp_grid_soa_types::host* soa) const {
+
+    // The seeds of every bin of middle spacepoints. The bins are processed
+    // in parallel, biggest first, and their seeds are collected in bin order
+    // at the end. So the result does not depend on the number of threads.
+    std::vector<output_type> bin_seeds(g2.nbins());
+    std::vector<std::size_t> bin_sizes(g2.nbins());
     for (unsigned int i = 0; i < g2.nbins(); i++) {
-        auto& spM_collection = g2.bin(i);
+        bin_sizes[i] = g2.bin(i).size();
+    }
+
+    // Scratch memory for every thread
+    std::vector<seed_finding_scratch> scratch(std::max(m_n_threads, 1u));
+
+    work_stealing_for_each(
+        largest_first(bin_sizes), m_n_threads,
+        [&](std::size_t i, unsigned int worker) {
+            find_seeds(sp_container, g2, soa, static_cast<unsigned int>(i),
+                       scratch[worker], bin_seeds[i]);
+        });
+
+    // Concatenate the seeds of the bins.
+    std::size_t n_seeds = 0;
+    for (const output_type& seeds : bin_seeds) {
+        n_seeds += seeds.size();
+    }
+    output_type seeds;
+    seeds.reserve(n_seeds);
+    for (const output_type& bin : bin_seeds) {
+        seeds.insert(seeds.end(), bin.begin(), bin.end());
+    }
+
+    return seeds;
+}
+
+void seed_finding::find_seeds(
+    const spacepoint_container_types::host& sp_container, const sp_grid& g2,
+    const sp_grid_soa_types::host* soa, unsigned int i,
+    seed_finding_scratch& scratch, output_type& seeds) const {
 
-        for (unsigned int j = 0; j < spM_collection.size(); ++j) {
+    const bool bottom = true;
+    const bool top = false;
 
-            sp_location spM_location({i, j});
+    auto& spM_collection = g2.bin(i);
 
-            // middule-bottom doublet search
-            auto mid_bot = m_doublet_finding(g2, spM_location, bottom);
+    for (unsigned int j = 0; j < spM_collection.size(); ++j) {
 
-            if (mid_bot.first.empty())
-                continue;
+        sp_location spM_location({i, j});
 
-            // middule-top doublet search
-            auto mid_top = m_doublet_finding(g2, spM_location, top);
+        // middule-bottom doublet search
+        auto& mid_bot = scratch.mid_bot;
+        mid_bot.first.clear();
+        mid_bot.second.clear();
+        if (soa != nullptr) {
+            m_doublet_finding(g2, *soa, spM_location, bottom, mid_bot);
+        } else {
+            m_doublet_finding(g2, spM_location, bottom, mid_bot);
+        }
 
-            if (mid_top.first.empty())
-                continue;
+        if (mid_bot.first.empty())
+            continue;
+
+        // middule-top doublet search
+        auto& mid_top = scratch.mid_top;
+        mid_top.first.clear();
+        mid_top.second.clear();
+        if (soa != nullptr) {
+            m_doublet_finding(g2, *soa, spM_location, top, mid_top);
+        } else {
+            m_doublet_finding(g2, spM_location, top, mid_top);
+        }
 
-            triplet_collection_types::host triplets_per_spM;
+        if (mid_top.first.empty())
+            continue;
 
-            // triplet search from the combinations of two doublets which
-            // share middle spacepoint
-            for (unsigned int k = 0; k < mid_bot.first.size(); ++k) {
-                auto& doublet_mb = mid_bot.first[k];
-                auto& lb = mid_bot.second[k];
+        auto& triplets_per_spM = scratch.triplets;
+        triplets_per_spM.clear();
 
-                triplet_collection_types::host triplets = m_triplet_finding(
-                    g2, doublet_mb, lb, mid_top.first, mid_top.second);
+        // order the middle-top doublets by cotTheta, once for all
+        // middle-bottom doublets
+        m_triplet_finding.sort_mid_top(mid_top.second,
+                                       scratch.triplet_finding);
 
-                triplets_per_spM.insert(std::end(triplets_per_spM),
-                                        triplets.begin(), triplets.end());
-            }
+        // triplet search from the combinations of two doublets which
+        // share middle spacepoint
+        for (unsigned int k = 0; k < mid_bot.first.size(); ++k) {
+            auto& doublet_mb = mid_bot.first[k];
+            auto& lb = mid_bot.second[k];
 
-            // seed filtering
-            m_seed_filtering(sp_container, g2, triplets_per_spM, seeds);
+            m_triplet_finding.append_triplets(
+                g2, doublet_mb, lb, mid_top.first, mid_top.second,
+                triplets_per_spM, scratch.triplet_finding);
         }
-    }
 
-    return seeds;
+        // seed filtering
+        m_seed_filtering(sp_container, g2, triplets_per_spM, seeds,
+                         scratch.filtering);
+    }
 }
 
 }  // namespace traccc
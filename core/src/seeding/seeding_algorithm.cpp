@@ -53,15 +53,22 @@ traccc::spacepoint_grid_config default_spacepoint_grid_config() {
 
 namespace traccc {
 
-seeding_algorithm::seeding_algorithm(vecmem::memory_resource& mr)
-    : m_spacepoint_binning(default_seedfinder_config(),
-                           default_spacepoint_grid_config(), mr),
-      m_seed_finding(default_seedfinder_config(), seedfilter_config()) {}
+seeding_algorithm::seeding_algorithm(vecmem::memory_resource& mr,
+                                     unsigned int n_threads)
+    : m_mr(mr),
+      m_spacepoint_binning(default_seedfinder_config(),
+                           default_spacepoint_grid_config(), mr, n_threads),
+      m_seed_finding(default_seedfinder_config(), seedfilter_config(),
+                     n_threads) {}
 
 seeding_algorithm::output_type seeding_algorithm::operator()(
     const spacepoint_container_types::host& spacepoints) const {
 
-    return m_seed_finding(spacepoints, m_spacepoint_binning(spacepoints));
+    // Bin the spacepoints, filling the structure-of-arrays description of
+    // the grid for the doublet finding at the same time.
+    sp_grid_soa_types::host soa(&(m_mr.get()));
+    const sp_grid g2 = m_spacepoint_binning(spacepoints, soa);
+    return m_seed_finding(spacepoints, g2, soa);
 }
 
 }  // namespace traccc
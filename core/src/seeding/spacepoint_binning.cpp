@@ -10,46 +10,157 @@
 
 #include "traccc/definitions/primitives.hpp"
 #include "traccc/seeding/spacepoint_binning_helper.hpp"
+#include "traccc/utils/work_stealing.hpp"
+
+// System include(s).
+#include <algorithm>
+#include <vector>
 
 namespace traccc {
 
 spacepoint_binning::spacepoint_binning(
     const seedfinder_config& config, const spacepoint_grid_config& grid_config,
-    vecmem::memory_resource& mr)
+    vecmem::memory_resource& mr, unsigned int n_threads)
     : m_config(config.toInternalUnits()),
       m_grid_config(grid_config.toInternalUnits()),
       m_axes(get_axes(grid_config.toInternalUnits(), mr)),
-      m_mr(mr) {}
+      m_mr(mr),
+      m_n_threads(n_threads) {}
 
 spacepoint_binning::output_type spacepoint_binning::operator()(
     const spacepoint_container_types::host& sp_container) const {
 
+    return fill(sp_container, nullptr);
+}
+
+spacepoint_binning::output_type spacepoint_binning::operator()(
+    const spacepoint_container_types::host& sp_container,
+    sp_grid_soa_types::host& soa) const {
+
+    return fill(sp_container, &soa);
+}
+
+spacepoint_binning::output_type spacepoint_binning::fill(
+    const spacepoint_container_types::host& sp_container,
+    sp_grid_soa_types::host* soa) const {
+
     output_type g2(m_axes.first, m_axes.second, m_mr.get());
+    const auto& phi_axis = g2.axis_p0();
+    const auto& z_axis = g2.axis_p1();
+
+    // The offset of the spacepoints of every module in the flattened
+    // spacepoint list.
+    const unsigned int n_modules = sp_container.size();
+    std::vector<unsigned int> sp_offsets(n_modules + 1, 0);
+    std::vector<std::size_t> module_sizes(n_modules);
+    for (unsigned int i = 0; i < n_modules; i++) {
+        module_sizes[i] = sp_container.get_items()[i].size();
+        sp_offsets[i + 1] = sp_offsets[i] + module_sizes[i];
+    }
+    const unsigned int n_spacepoints = sp_offsets.back();
 
-    djagged_vector<sp_location> rbins(m_config.get_num_rbins());
+    // Pass one: find the grid bin and radius bin of every spacepoint, in
+    // parallel over the modules. Spacepoints that can not be used for
+    // seeding get an invalid grid bin.
+    const unsigned int invalid_bin =
+        detray::detail::invalid_value<unsigned int>();
+    std::vector<internal_spacepoint<spacepoint>> isps(n_spacepoints);
+    std::vector<unsigned int> grid_bins(n_spacepoints, invalid_bin);
+    std::vector<std::size_t> r_bins(n_spacepoints);
+    work_stealing_for_each(
+        largest_first(module_sizes), m_n_threads,
+        [&](std::size_t i, unsigned int) {
+            const auto& spacepoints = sp_container.get_items()[i];
+            for (unsigned int j = 0; j < spacepoints.size(); j++) {
+                const std::size_t r_index =
+                    is_valid_sp(m_config, spacepoints[j]);
+                if (r_index == detray::detail::invalid_value<std::size_t>()) {
+                    continue;
+                }
+                const unsigned int k = sp_offsets[i] + j;
+                isps[k] = internal_spacepoint<spacepoint>(
+                    sp_container, {i, j}, m_config.beamPos);
+                grid_bins[k] = phi_axis.bin(isps[k].phi()) +
+                               phi_axis.bins() * z_axis.bin(isps[k].z());
+                r_bins[k] = r_index;
+            }
+        });
 
-    for (unsigned int i = 0; i < sp_container.size(); i++) {
-        for (unsigned int j = 0; j < sp_container.get_items()[i].size(); j++) {
-            sp_location sp_loc{i, j};
-            fill_radius_bins<spacepoint_container_types::host, djagged_vector>(
-                m_config, sp_container, sp_loc, rbins);
+    // Pass two: count the spacepoints of every grid bin, and place their
+    // indices at the offsets of their bins in one flat list. Only indices
+    // are moved around here, so this stays a serial pass.
+    std::vector<unsigned int> bin_sizes(g2.nbins(), 0);
+    for (unsigned int grid_bin : grid_bins) {
+        if (grid_bin != invalid_bin) {
+            ++bin_sizes[grid_bin];
+        }
+    }
+    std::vector<unsigned int> bin_offsets(g2.nbins() + 1, 0);
+    for (unsigned int i = 0; i < g2.nbins(); i++) {
+        bin_offsets[i + 1] = bin_offsets[i] + bin_sizes[i];
+    }
+    const unsigned int n_binned = bin_offsets.back();
+    std::vector<unsigned int> bin_members(n_binned);
+    {
+        std::vector<unsigned int> cursors(bin_offsets.begin(),
+                                          bin_offsets.end() - 1);
+        for (unsigned int k = 0; k < n_spacepoints; k++) {
+            if (grid_bins[k] != invalid_bin) {
+                bin_members[cursors[grid_bins[k]]++] = k;
+            }
         }
     }
 
-    // fill rbins into grid such that each grid bin is sorted in r
-    // space points with delta r < rbin size can be out of order
-    for (auto& rbin : rbins) {
-        for (auto& sp_loc : rbin) {
-
-            auto isp = internal_spacepoint<spacepoint>(
-                sp_container, {sp_loc.bin_idx, sp_loc.sp_idx},
-                m_config.beamPos);
+    // The detray grid keeps every bin in its own vector, allocated from the
+    // memory resource of the grid. Those are allocated here, one per bin,
+    // since the memory resource need not be thread safe.
+    for (unsigned int i = 0; i < g2.nbins(); i++) {
+        g2.bin(i).reserve(bin_sizes[i]);
+    }
 
-            point2 sp_position = {isp.phi(), isp.z()};
-            g2.populate(sp_position, std::move(isp));
-        }
+    // Set up the structure-of-arrays description with the same bin sizes.
+    if (soa != nullptr) {
+        soa->bin_offsets.assign(bin_offsets.begin(), bin_offsets.end());
+        soa->r_bins.resize(n_binned);
+        soa->r.resize(n_binned);
+        soa->z.resize(n_binned);
     }
 
+    // Sort the spacepoints of every grid bin by radius bin, and move them
+    // into the bin, in parallel over the bins. Spacepoints of the same
+    // radius bin are kept in the order of the container, like when filling
+    // the grid from radius bins. They are not sorted in radius, since the
+    // seed weights depend on the order of the spacepoints.
+    work_stealing_for_each(
+        largest_first(bin_sizes), m_n_threads,
+        [&](std::size_t i, unsigned int) {
+            const auto first = bin_members.begin() + bin_offsets[i];
+            const auto last = bin_members.begin() + bin_offsets[i + 1];
+            std::sort(first, last, [&](unsigned int k1, unsigned int k2) {
+                if (r_bins[k1] != r_bins[k2]) {
+                    return r_bins[k1] < r_bins[k2];
+                }
+                return k1 < k2;
+            });
+
+            auto& bin = g2.bin(i);
+            for (auto it = first; it != last; ++it) {
+                bin.push_back(std::move(isps[*it]));
+            }
+
+            // Copy the properties of the sorted spacepoints into their range
+            // of the structure-of-arrays description.
+            if (soa != nullptr) {
+                const unsigned int offset = bin_offsets[i];
+                for (unsigned int j = 0; j < bin.size(); j++) {
+                    soa->r_bins[offset + j] = static_cast<unsigned int>(
+                        r_bins[bin_members[offset + j]]);
+                    soa->r[offset + j] = bin[j].radius();
+                    soa->z[offset + j] = bin[j].z();
+                }
+            }
+        });
+
     return g2;
 }
 
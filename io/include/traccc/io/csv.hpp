@@ -16,6 +16,7 @@
 #include "traccc/edm/spacepoint.hpp"
 #include "traccc/edm/track_parameters.hpp"
 #include "traccc/geometry/geometry.hpp"
+#include "traccc/geometry/pixel_mask.hpp"
 #include "traccc/io/detail/json_digitization_config.hpp"
 
 // Acts include(s)
@@ -221,6 +222,31 @@ inline std::map<geometry_id, transform3> read_surfaces(
     return transform_map;
 }
 
+struct csv_masked_pixel {
+
+    uint64_t geometry_id = 0;
+    channel_id channel0 = 0;
+    channel_id channel1 = 0;
+
+    // geometry_id,channel0,channel1
+    DFE_NAMEDTUPLE(csv_masked_pixel, geometry_id, channel0, channel1);
+};
+
+using pixel_mask_reader = dfe::NamedTupleCsvReader<csv_masked_pixel>;
+
+/// Read the (noisy or dead) pixels to mask for every module
+///
+/// @param preader The masked pixel reader type
+inline pixel_mask read_pixel_mask(pixel_mask_reader& preader) {
+
+    pixel_mask mask;
+    csv_masked_pixel iopixel;
+    while (preader.read(iopixel)) {
+        mask.add(iopixel.geometry_id, iopixel.channel0, iopixel.channel1);
+    }
+    return mask;
+}
+
 /// Read the collection of cells per module and fill into a collection
 ///
 /// @param creader The cellreader type
@@ -271,9 +297,18 @@ inline cell_container_types::host read_cells(
                     const auto& binning_data =
                         geo_it->segmentation.binningData();
 
-                    module.pixel =
-                        pixel_data{binning_data[0].min, binning_data[1].min,
-                                   binning_data[0].step, binning_data[1].step};
+                    // Strip modules are only segmented along one direction.
+                    // The digitization configuration does not provide the
+                    // length of their strips, so the second direction gets
+                    // placeholder values. (See traccc::pixel_data.)
+                    if (binning_data.size() > 1) {
+                        module.pixel = pixel_data{
+                            binning_data[0].min, binning_data[1].min,
+                            binning_data[0].step, binning_data[1].step, 2};
+                    } else if (binning_data.size() == 1) {
+                        module.pixel = pixel_data{binning_data[0].min, 0.,
+                                                  binning_data[0].step, 1., 1};
+                    }
                 }
             }
 
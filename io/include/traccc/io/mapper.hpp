@@ -203,17 +203,23 @@ measurement_cell_map generate_measurement_cell_map(
         read_cells_from_event(event, cells_dir, traccc::data_format::csv,
                               surface_transforms, digi_cfg, resource);
 
-    auto clusters_per_event = cc(cells_per_event);
+    // Only the cell indices of the clusters are needed, the cells are copied
+    // into the map just once.
+    auto clusters_per_event = cc.cluster_indices(cells_per_event);
     auto measurements_per_event = mc(cells_per_event, clusters_per_event);
 
     for (std::size_t i = 0; i < measurements_per_event.size(); ++i) {
         const auto& measurements = measurements_per_event.get_items()[i];
 
         for (const auto& meas : measurements) {
-            const auto& clus =
-                clusters_per_event.get_items()[meas.cluster_link];
-
-            result[meas] = clus;
+            const auto clus =
+                clusters_per_event.cells(cells_per_event, meas.cluster_link);
+
+            auto& cells = result[meas];
+            cells.reserve(clus.size());
+            for (const cell& c : clus) {
+                cells.push_back(c);
+            }
         }
     }
 
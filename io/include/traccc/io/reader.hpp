@@ -43,6 +43,16 @@ inline traccc::geometry read_geometry(const std::string &detector_file) {
     return traccc::read_surfaces(sreader);
 }
 
+/// Function for reading the pixels to mask from a CSV file
+///
+/// @param mask_file is the file listing the masked pixels of every module
+inline traccc::pixel_mask read_pixel_mask(const std::string &mask_file) {
+    std::string io_mask_file = data_directory() + mask_file;
+    traccc::pixel_mask_reader preader(io_mask_file,
+                                      {"geometry_id", "channel0", "channel1"});
+    return traccc::read_pixel_mask(preader);
+}
+
 /// Function for digtization configuration reading. The output is Acts
 /// GeometryHierarchyMap.
 ///
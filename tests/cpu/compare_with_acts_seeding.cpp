@@ -139,6 +139,18 @@ TEST_P(CompareWithActsSeedingTests, Run) {
     auto internal_spacepoints_per_event = sb(spacepoints_per_event);
     auto seeds = sf(spacepoints_per_event, internal_spacepoints_per_event);
 
+    // The seeds must not depend on the number of threads used
+    traccc::seed_finding sf_mt(traccc_config, traccc::seedfilter_config(), 4);
+    auto seeds_mt =
+        sf_mt(spacepoints_per_event, internal_spacepoints_per_event);
+    ASSERT_EQ(seeds_mt.size(), seeds.size());
+    for (std::size_t i = 0; i < seeds.size(); ++i) {
+        EXPECT_EQ(seeds_mt[i].spB_link, seeds[i].spB_link);
+        EXPECT_EQ(seeds_mt[i].spM_link, seeds[i].spM_link);
+        EXPECT_EQ(seeds_mt[i].spT_link, seeds[i].spT_link);
+        EXPECT_EQ(seeds_mt[i].weight, seeds[i].weight);
+    }
+
     /*--------------------------------
       TRACCC track params estimation
       --------------------------------*/
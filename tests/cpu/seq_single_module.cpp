@@ -6,18 +6,26 @@
  */
 
 // Project include(s).
+#include "traccc/clusterization/clusterization_algorithm.hpp"
 #include "traccc/clusterization/component_connection.hpp"
+#include "traccc/clusterization/fused_clusterization.hpp"
 #include "traccc/clusterization/measurement_creation.hpp"
 #include "traccc/clusterization/spacepoint_formation.hpp"
 #include "traccc/edm/cell.hpp"
 #include "traccc/edm/cluster.hpp"
 #include "traccc/edm/measurement.hpp"
 #include "traccc/edm/spacepoint.hpp"
+#include "traccc/geometry/geometry.hpp"
 #include "traccc/geometry/pixel_data.hpp"
+#include "traccc/geometry/region_of_interest.hpp"
 
 // VecMem include(s).
 #include <vecmem/memory/host_memory_resource.hpp>
 
+// System include(s).
+#include <map>
+#include <vector>
+
 // GTest include(s).
 #include <gtest/gtest.h>
 
@@ -52,3 +60,171 @@ TEST(algorithms, seq_single_module) {
 
     EXPECT_EQ(measurements.at(0).items.size(), 4u);
 }
+
+TEST(algorithms, seq_multi_module_multithreaded) {
+
+    // Memory resource used in the test.
+    vecmem::host_memory_resource resource;
+
+    traccc::component_connection cc(resource);
+    traccc::component_connection cc_mt(resource,
+                                       traccc::clusterization_config{3});
+    traccc::measurement_creation mc(resource);
+    traccc::measurement_creation mc_mt(resource,
+                                       traccc::clusterization_config{3});
+
+    // Modules with different numbers of (shifted) copies of the cells of the
+    // single module test, to give the threads uneven amounts of work
+    const traccc::cell_collection_types::host cells_per_module = {
+        {{1, 0, 1., 0.},
+         {8, 4, 2., 0.},
+         {10, 4, 3., 0.},
+         {9, 5, 4., 0.},
+         {10, 5, 5., 0},
+         {12, 12, 6, 0},
+         {3, 13, 7, 0},
+         {11, 13, 8, 0},
+         {4, 14, 9, 0}},
+        &resource};
+
+    traccc::cell_container_types::host cells;
+    for (std::size_t i = 0; i < 10; ++i) {
+        traccc::cell_module module;
+        module.module = i;
+        traccc::cell_collection_types::host module_cells(&resource);
+        // (Module 4 is left empty.)
+        for (std::size_t j = 0; (i != 4) && (j < (i * 7) % 10 + 1); ++j) {
+            for (traccc::cell c : cells_per_module) {
+                c.channel1 += j * 20;
+                module_cells.push_back(c);
+            }
+        }
+        cells.push_back(module, module_cells);
+    }
+
+    auto clusters = cc(cells);
+    auto clusters_mt = cc_mt(cells);
+
+    // The two results need to be identical, including their ordering
+    ASSERT_EQ(clusters.size(), clusters_mt.size());
+    for (std::size_t i = 0; i < clusters.size(); ++i) {
+        EXPECT_EQ(clusters.at(i).header, clusters_mt.at(i).header);
+        EXPECT_EQ(clusters.at(i).items, clusters_mt.at(i).items);
+    }
+
+    // The same is true for the measurements
+    auto measurements = mc(cells, clusters);
+    auto measurements_mt = mc_mt(cells, clusters);
+    ASSERT_EQ(measurements.size(), 9u);
+    ASSERT_EQ(measurements.size(), measurements_mt.size());
+    for (std::size_t i = 0; i < measurements.size(); ++i) {
+        EXPECT_EQ(measurements.at(i).header.module,
+                  measurements_mt.at(i).header.module);
+        EXPECT_EQ(measurements.at(i).items, measurements_mt.at(i).items);
+    }
+    EXPECT_EQ(measurements.at(4).header.module, 5u);
+}
+
+TEST(algorithms, seq_multi_module_fused) {
+
+    // Memory resource used in the test.
+    vecmem::host_memory_resource resource;
+
+    traccc::component_connection cc(resource);
+    traccc::measurement_creation mc(resource);
+    traccc::fused_clusterization fc(resource);
+
+    const traccc::cell_collection_types::host cells_per_module = {
+        {{1, 0, 1., 0.},
+         {8, 4, 2., 0.},
+         {10, 4, 3., 0.},
+         {9, 5, 4., 0.},
+         {10, 5, 5., 0},
+         {12, 12, 6, 0},
+         {3, 13, 7, 0},
+         {11, 13, 8, 0},
+         {4, 14, 9, 0}},
+        &resource};
+
+    // Modules with different pixel geometries and thresholds
+    traccc::cell_container_types::host cells;
+    for (std::size_t i = 0; i < 4; ++i) {
+        traccc::cell_module module;
+        module.module = i;
+        module.threshold = 2.5f * i;
+        module.pixel = {-1.f * i, 2.f * i, 0.05f * (i + 1), 0.1f};
+        cells.push_back(module, cells_per_module);
+    }
+
+    auto measurements = mc(cells, cc(cells));
+    auto measurements_fused = fc(cells);
+
+    // The two results need to be identical, including the cluster links
+    ASSERT_EQ(measurements.size(), measurements_fused.size());
+    for (std::size_t i = 0; i < measurements.size(); ++i) {
+        EXPECT_EQ(measurements.at(i).header.module,
+                  measurements_fused.at(i).header.module);
+        ASSERT_EQ(measurements.at(i).items.size(),
+                  measurements_fused.at(i).items.size());
+        for (std::size_t j = 0; j < measurements.at(i).items.size(); ++j) {
+            EXPECT_EQ(measurements.at(i).items[j],
+                      measurements_fused.at(i).items[j]);
+            EXPECT_EQ(measurements.at(i).items[j].cluster_link,
+                      measurements_fused.at(i).items[j].cluster_link);
+        }
+    }
+}
+
+TEST(algorithms, seq_multi_module_region_of_interest) {
+
+    // Memory resource used in the test.
+    vecmem::host_memory_resource resource;
+
+    traccc::clusterization_algorithm ca(resource);
+    traccc::fused_clusterization fc(resource);
+
+    const traccc::cell_collection_types::host cells_per_module = {
+        {{1, 0, 1., 0.}, {8, 4, 2., 0.}, {10, 4, 3., 0.}, {9, 5, 4., 0.}},
+        &resource};
+
+    // Three modules facing the beam line, at phi = 0, pi/2 and pi
+    traccc::cell_container_types::host cells;
+    std::map<traccc::geometry_id, traccc::transform3> placements;
+    const traccc::point3 positions[3] = {
+        {100., 0., 0.}, {0., 100., 0.}, {-100., 0., 0.}};
+    for (std::size_t i = 0; i < 3; ++i) {
+        traccc::cell_module module;
+        module.module = i;
+        module.pixel = {0.f, 0.f, 0.05f, 0.05f};
+        cells.push_back(module, cells_per_module);
+        const traccc::vector3 normal = {positions[i][0] / 100.f,
+                                        positions[i][1] / 100.f, 0.};
+        placements.insert({module.module,
+                           traccc::transform3{positions[i], normal,
+                                              traccc::vector3{0., 0., 1.}}});
+    }
+    const traccc::geometry geom(placements);
+
+    // Only the module(s) overlapping with the regions are processed, with
+    // the cluster links counting the clusters of the selected modules.
+    std::vector<traccc::region_of_interest> rois(1);
+    rois[0] = {0., 0., 0.1, 0.1};
+    const std::vector<std::size_t> first = {0};
+    auto measurements = ca(cells, geom, rois);
+    auto measurements_ref = fc(cells, first);
+    ASSERT_EQ(measurements.size(), 1u);
+    EXPECT_EQ(measurements.at(0).header.module, 0u);
+    EXPECT_EQ(measurements.at(0).items, measurements_ref.at(0).items);
+
+    // Regions around the +-pi boundary are found on either side of it
+    const std::vector<std::size_t> last = {2};
+    rois[0] = {0., -3.1, 0.1, 0.1};
+    measurements = ca(cells, geom, rois);
+    measurements_ref = fc(cells, last);
+    ASSERT_EQ(measurements.size(), 1u);
+    EXPECT_EQ(measurements.at(0).header.module, 2u);
+    EXPECT_EQ(measurements.at(0).items, measurements_ref.at(0).items);
+
+    // No module is processed without a region of interest
+    EXPECT_EQ(ca(cells, geom, {}).size(), 0u);
+}
@@ -7,6 +7,7 @@
 
 // Project include(s).
 #include "traccc/clusterization/clusterization_algorithm.hpp"
+#include "traccc/clusterization/fast_sv_clusterization.hpp"
 #include "traccc/definitions/primitives.hpp"
 #include "traccc/edm/cell.hpp"
 #include "traccc/edm/cluster.hpp"
@@ -21,22 +22,70 @@
 #include <gtest/gtest.h>
 
 // System include(s).
+#include <algorithm>
 #include <functional>
 
 namespace {
 vecmem::host_memory_resource resource;
 traccc::clusterization_algorithm ca(resource);
+traccc::clusterization_algorithm ca_mt(resource,
+                                       traccc::clusterization_config{4});
+// Use the dense CCL engine for every module
+traccc::clusterization_algorithm ca_dense(
+    resource, traccc::clusterization_config{1, 0.f, 0});
+// Use the run-length CCL engine for every module
+traccc::clusterization_algorithm ca_run_length(
+    resource, traccc::clusterization_config{1, 2.f, 0,
+                                            traccc::ccl_engine::run_length});
 
-cca_function_t f = [](const traccc::cell_container_types::host &data) {
-    std::map<traccc::geometry_id, vecmem::vector<traccc::measurement>> result;
+// Split every module into strips, labelled on multiple threads
+traccc::clusterization_algorithm ca_strips(
+    resource, traccc::clusterization_config{4, 0.05f, 64,
+                                            traccc::ccl_engine::sparse, 1});
+// Use the hash-based CCL engine for every module
+traccc::clusterization_algorithm ca_hash(
+    resource,
+    traccc::clusterization_config{1, 2.f, 0, traccc::ccl_engine::hash});
 
-    auto measurements = ca(data);
-    for (std::size_t i = 0; i < measurements.size(); i++) {
-        result[measurements.at(i).header.module] = measurements.at(i).items;
-    }
+traccc::fast_sv_clusterization fast_sv(resource);
 
-    return result;
-};
+template <typename algorithm_t>
+cca_function_t make_cca_function(const algorithm_t &alg) {
+    return [&alg](const traccc::cell_container_types::host &data) {
+        std::map<traccc::geometry_id, vecmem::vector<traccc::measurement>>
+            result;
+
+        auto measurements = alg(data);
+        for (std::size_t i = 0; i < measurements.size(); i++) {
+            result[measurements.at(i).header.module] =
+                measurements.at(i).items;
+        }
+
+        return result;
+    };
+}
+
+// Feed the algorithm with the cells of every module in reverse order
+template <typename algorithm_t>
+cca_function_t make_unsorted_cca_function(const algorithm_t &alg) {
+    return [f = make_cca_function(alg)](
+               const traccc::cell_container_types::host &data) {
+        traccc::cell_container_types::host unsorted = data;
+        for (std::size_t i = 0; i < unsorted.size(); i++) {
+            auto &cells = unsorted.get_items()[i];
+            std::reverse(cells.begin(), cells.end());
+        }
+        return f(unsorted);
+    };
+}
+
+cca_function_t f = make_cca_function(ca);
+cca_function_t f_mt = make_cca_function(ca_mt);
+cca_function_t f_dense = make_cca_function(ca_dense);
+cca_function_t f_run_length = make_cca_function(ca_run_length);
+cca_function_t f_strips = make_cca_function(ca_strips);
+cca_function_t f_hash = make_unsorted_cca_function(ca_hash);
+cca_function_t f_fast_sv = make_cca_function(fast_sv);
 }  // namespace
 
 TEST_P(ConnectedComponentAnalysisTests, Run) {
@@ -49,3 +98,45 @@ INSTANTIATE_TEST_SUITE_P(
         ::testing::Values(f),
         ::testing::ValuesIn(ConnectedComponentAnalysisTests::get_test_files())),
     ConnectedComponentAnalysisTests::get_test_name);
+
+INSTANTIATE_TEST_SUITE_P(
+    SparseCclAlgorithmMultiThreaded, ConnectedComponentAnalysisTests,
+    ::testing::Combine(
+        ::testing::Values(f_mt),
+        ::testing::ValuesIn(ConnectedComponentAnalysisTests::get_test_files())),
+    ConnectedComponentAnalysisTests::get_test_name);
+
+INSTANTIATE_TEST_SUITE_P(
+    DenseCclAlgorithm, ConnectedComponentAnalysisTests,
+    ::testing::Combine(
+        ::testing::Values(f_dense),
+        ::testing::ValuesIn(ConnectedComponentAnalysisTests::get_test_files())),
+    ConnectedComponentAnalysisTests::get_test_name);
+
+INSTANTIATE_TEST_SUITE_P(
+    RunLengthCclAlgorithm, ConnectedComponentAnalysisTests,
+    ::testing::Combine(
+        ::testing::Values(f_run_length),
+        ::testing::ValuesIn(ConnectedComponentAnalysisTests::get_test_files())),
+    ConnectedComponentAnalysisTests::get_test_name);
+
+INSTANTIATE_TEST_SUITE_P(
+    StripCclAlgorithm, ConnectedComponentAnalysisTests,
+    ::testing::Combine(
+        ::testing::Values(f_strips),
+        ::testing::ValuesIn(ConnectedComponentAnalysisTests::get_test_files())),
+    ConnectedComponentAnalysisTests::get_test_name);
+
+INSTANTIATE_TEST_SUITE_P(
+    HashCclAlgorithmUnsorted, ConnectedComponentAnalysisTests,
+    ::testing::Combine(
+        ::testing::Values(f_hash),
+        ::testing::ValuesIn(ConnectedComponentAnalysisTests::get_test_files())),
+    ConnectedComponentAnalysisTests::get_test_name);
+
+INSTANTIATE_TEST_SUITE_P(
+    FastSvAlgorithm, ConnectedComponentAnalysisTests,
+    ::testing::Combine(
+        ::testing::Values(f_fast_sv),
+        ::testing::ValuesIn(ConnectedComponentAnalysisTests::get_test_files())),
+    ConnectedComponentAnalysisTests::get_test_name);
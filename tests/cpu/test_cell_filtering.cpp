@@ -0,0 +1,134 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2022 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+// Project include(s).
+#include "traccc/clusterization/cell_filtering.hpp"
+#include "traccc/clusterization/clusterization_algorithm.hpp"
+#include "traccc/edm/cell.hpp"
+#include "traccc/edm/measurement.hpp"
+#include "traccc/geometry/pixel_mask.hpp"
+
+// VecMem include(s).
+#include <vecmem/memory/host_memory_resource.hpp>
+
+// GTest include(s).
+#include <gtest/gtest.h>
+
+TEST(cell_filtering, threshold_and_mask) {
+
+    // Memory resource used in the test.
+    vecmem::host_memory_resource resource;
+
+    traccc::cell_container_types::host cells(&resource);
+
+    // Module with a threshold, and a noisy pixel.
+    traccc::cell_module module1;
+    module1.module = 1;
+    module1.threshold = 2.;
+    cells.push_back(module1, traccc::cell_collection_types::host{
+                                 {{1, 0, 1., 0.},
+                                  {8, 4, 2., 0.},
+                                  {10, 4, 3., 0.},
+                                  {9, 5, 4., 0.},
+                                  {12, 12, 6., 0.}},
+                                 &resource});
+
+    // Module with only cells below threshold.
+    traccc::cell_module module2;
+    module2.module = 2;
+    module2.threshold = 5.;
+    cells.push_back(module2,
+                    traccc::cell_collection_types::host{
+                        {{3, 13, 1., 0.}, {4, 14, 2., 0.}}, &resource});
+
+    // Module without a threshold, with only masked pixels.
+    traccc::cell_module module3;
+    module3.module = 3;
+    cells.push_back(module3, traccc::cell_collection_types::host{
+                                 {{5, 5, 1., 0.}}, &resource});
+
+    // Module without a threshold or masked pixels.
+    traccc::cell_module module4;
+    module4.module = 4;
+    cells.push_back(module4,
+                    traccc::cell_collection_types::host{
+                        {{7, 1, 0.5, 0.}, {7, 2, 0.5, 0.}}, &resource});
+
+    traccc::pixel_mask mask;
+    mask.add(1, 9, 5);
+    mask.add(3, 5, 5);
+    mask.add(4, 8, 1);
+
+    traccc::cell_filtering filtering(mask);
+    const traccc::cell_container_types::host filtered =
+        filtering(std::move(cells));
+
+    // Only modules 1 and 4 need to be left, with their cells in the original
+    // order.
+    ASSERT_EQ(filtered.size(), 2u);
+    EXPECT_EQ(filtered.at(0).header.module, 1u);
+    EXPECT_EQ(filtered.at(0).items,
+              (traccc::cell_collection_types::host{
+                  {{10, 4, 3., 0.}, {12, 12, 6., 0.}}, &resource}));
+    EXPECT_EQ(filtered.at(0).header.range0[0], 10u);
+    EXPECT_EQ(filtered.at(0).header.range0[1], 12u);
+    EXPECT_EQ(filtered.at(0).header.range1[0], 4u);
+    EXPECT_EQ(filtered.at(0).header.range1[1], 12u);
+    EXPECT_EQ(filtered.at(1).header.module, 4u);
+    EXPECT_EQ(filtered.at(1).items.size(), 2u);
+}
+
+TEST(cell_filtering, bridging_cell_below_threshold) {
+
+    // Memory resource used in the test.
+    vecmem::host_memory_resource resource;
+
+    // Two cells above threshold, connected only through a cell below
+    // threshold.
+    traccc::cell_module module;
+    module.module = 1;
+    module.threshold = 2.;
+    module.pixel = {0.f, 0.f, 1.f, 1.f};
+    const traccc::cell_collection_types::host module_cells{
+        {{1, 0, 5., 0.}, {2, 0, 1., 0.}, {3, 0, 5., 0.}}, &resource};
+
+    traccc::clusterization_algorithm ca(resource);
+
+    // Without filtering, the three cells form one cluster.
+    traccc::cell_container_types::host cells(&resource);
+    cells.push_back(module, module_cells);
+    const traccc::measurement_container_types::host measurements = ca(cells);
+    ASSERT_EQ(measurements.size(), 1u);
+    ASSERT_EQ(measurements.get_items()[0].size(), 1u);
+    EXPECT_FLOAT_EQ(measurements.get_items()[0][0].local[0], 2.);
+
+    // Removing the cells below threshold splits the cluster in two.
+    traccc::cell_container_types::host cells_filtered(&resource);
+    cells_filtered.push_back(module, module_cells);
+    const traccc::measurement_container_types::host measurements_filtered =
+        ca(traccc::cell_filtering()(std::move(cells_filtered)));
+    ASSERT_EQ(measurements_filtered.size(), 1u);
+    ASSERT_EQ(measurements_filtered.get_items()[0].size(), 2u);
+    EXPECT_FLOAT_EQ(measurements_filtered.get_items()[0][0].local[0], 1.);
+    EXPECT_FLOAT_EQ(measurements_filtered.get_items()[0][1].local[0], 3.);
+
+    // Which can be avoided by only removing the masked cells.
+    traccc::clusterization_config config;
+    config.filter_below_threshold = false;
+    traccc::cell_container_types::host cells_masked(&resource);
+    cells_masked.push_back(module, module_cells);
+    const traccc::cell_container_types::host masked =
+        traccc::cell_filtering({}, config)(std::move(cells_masked));
+    ASSERT_EQ(masked.size(), 1u);
+    EXPECT_EQ(masked.get_items()[0], module_cells);
+    const traccc::measurement_container_types::host measurements_masked =
+        ca(masked);
+    ASSERT_EQ(measurements_masked.size(), 1u);
+    ASSERT_EQ(measurements_masked.get_items()[0].size(), 1u);
+    EXPECT_EQ(measurements_masked.get_items()[0][0],
+              measurements.get_items()[0][0]);
+}
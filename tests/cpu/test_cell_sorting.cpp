@@ -0,0 +1,87 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2022 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+// Project include(s).
+#include "traccc/clusterization/cell_sorting.hpp"
+#include "traccc/edm/cell.hpp"
+
+// VecMem include(s).
+#include <vecmem/memory/host_memory_resource.hpp>
+
+// GTest include(s).
+#include <gtest/gtest.h>
+
+// System include(s).
+#include <algorithm>
+#include <random>
+
+namespace {
+
+/// Create an event with modules of different sizes, with unordered cells
+traccc::cell_container_types::host make_cells(vecmem::memory_resource& mr) {
+
+    std::mt19937 gen(42);
+    traccc::cell_container_types::host cells(&mr);
+    for (unsigned int i = 0; i < 20; ++i) {
+        traccc::cell_module module;
+        module.module = i;
+
+        // Use large channel values for some of the modules, to exercise
+        // multiple radix sort passes.
+        std::uniform_int_distribution<traccc::channel_id> channel(
+            (i % 4) * 1000, (i % 4) * 1000 + 10 + (i % 5) * 200);
+        traccc::cell_collection_types::host module_cells(&mr);
+        for (unsigned int j = 0; j < i * 50; ++j) {
+            module_cells.push_back({channel(gen), channel(gen),
+                                    static_cast<traccc::scalar>(j), 0.});
+        }
+        cells.push_back(module, module_cells);
+    }
+    return cells;
+}
+
+}  // namespace
+
+TEST(cell_sorting, column_major) {
+
+    // Memory resource used in the test.
+    vecmem::host_memory_resource resource;
+
+    for (unsigned int n_threads : {1u, 4u}) {
+
+        traccc::cell_container_types::host cells = make_cells(resource);
+
+        // Sort a copy with std::stable_sort, as the reference.
+        traccc::cell_container_types::host reference = make_cells(resource);
+        for (std::size_t i = 0; i < reference.size(); ++i) {
+            std::stable_sort(
+                reference.get_items()[i].begin(),
+                reference.get_items()[i].end(),
+                [](const traccc::cell& a, const traccc::cell& b) {
+                    return (a.channel1 < b.channel1) ||
+                           ((a.channel1 == b.channel1) &&
+                            (a.channel0 < b.channel0));
+                });
+        }
+
+        traccc::cell_sorting sorting(traccc::clusterization_config{n_threads});
+        const traccc::cell_container_types::host sorted =
+            sorting(std::move(cells));
+
+        // The sorting is stable, so the results need to be identical.
+        ASSERT_EQ(sorted.size(), reference.size());
+        for (std::size_t i = 0; i < sorted.size(); ++i) {
+            EXPECT_EQ(sorted.at(i).items, reference.at(i).items);
+            if (sorted.at(i).items.empty() == false) {
+                EXPECT_EQ(sorted.at(i).header.range1[0],
+                          sorted.at(i).items.front().channel1);
+                EXPECT_EQ(sorted.at(i).header.range1[1],
+                          sorted.at(i).items.back().channel1);
+            }
+        }
+    }
+}
@@ -0,0 +1,142 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2022 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+// Project include(s).
+#include "traccc/clusterization/component_connection.hpp"
+#include "traccc/clusterization/measurement_creation.hpp"
+#include "traccc/edm/cell.hpp"
+#include "traccc/edm/cluster.hpp"
+#include "traccc/edm/measurement.hpp"
+
+// VecMem include(s).
+#include <vecmem/memory/host_memory_resource.hpp>
+
+// GTest include(s).
+#include <gtest/gtest.h>
+
+// System include(s).
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+/// Create a cell container with a few modules, one of them empty
+traccc::cell_container_types::host make_cells(vecmem::memory_resource& mr) {
+
+    const traccc::cell_collection_types::host cells_per_module = {
+        {{1, 0, 1., 0.},
+         {8, 4, 2., 0.},
+         {10, 4, 3., 0.},
+         {9, 5, 4., 0.},
+         {10, 5, 5., 0},
+         {12, 12, 6, 0},
+         {3, 13, 7, 0},
+         {11, 13, 8, 0},
+         {4, 14, 9, 0}},
+        &mr};
+
+    traccc::cell_container_types::host cells(&mr);
+    for (std::size_t i = 0; i < 4; ++i) {
+        traccc::cell_module module;
+        module.module = i;
+        module.threshold = 2.5f * i;
+        module.pixel = {-1.f * i, 2.f * i, 0.05f * (i + 1), 0.1f};
+        cells.push_back(module, (i == 2) ? traccc::cell_collection_types::host{
+                                               &mr}
+                                         : cells_per_module);
+    }
+    return cells;
+}
+
+}  // namespace
+
+TEST(cluster_indices, same_as_cluster_copies) {
+
+    // Memory resource used in the test.
+    vecmem::host_memory_resource resource;
+    const traccc::cell_container_types::host cells = make_cells(resource);
+
+    traccc::component_connection cc(resource);
+    const traccc::cluster_container_types::host clusters = cc(cells);
+    const traccc::cluster_index_types::host indices = cc.cluster_indices(cells);
+
+    // The same clusters, in the same order.
+    ASSERT_EQ(indices.size(), clusters.size());
+    ASSERT_EQ(indices.cell_offsets.size(), clusters.size() + 1);
+    EXPECT_EQ(indices.cell_offsets.back(), cells.total_size());
+    for (std::size_t i = 0; i < clusters.size(); ++i) {
+        EXPECT_EQ(indices.module_links[i], clusters.get_headers()[i]);
+        const auto cluster = indices.cells(cells, i);
+        ASSERT_EQ(cluster.size(), clusters.get_items()[i].size());
+        for (unsigned int j = 0; j < cluster.size(); ++j) {
+            EXPECT_EQ(cluster[j], clusters.get_items()[i][j]);
+        }
+    }
+
+    // Every cell of a module belongs to exactly one of its clusters.
+    std::vector<unsigned int> cell_indices(indices.cell_indices.begin(),
+                                           indices.cell_indices.end());
+    for (std::size_t i = 0, offset = 0; i < cells.size(); ++i) {
+        const std::size_t n_cells = cells.get_items()[i].size();
+        std::sort(cell_indices.begin() + offset,
+                  cell_indices.begin() + offset + n_cells);
+        for (std::size_t j = 0; j < n_cells; ++j) {
+            EXPECT_EQ(cell_indices[offset + j], j);
+        }
+        offset += n_cells;
+    }
+
+    // The measurements are the same for both descriptions of the clusters.
+    traccc::measurement_creation mc(resource);
+    const traccc::measurement_container_types::host measurements =
+        mc(cells, clusters);
+    const traccc::measurement_container_types::host index_measurements =
+        mc(cells, indices);
+    ASSERT_EQ(index_measurements.size(), measurements.size());
+    for (std::size_t i = 0; i < measurements.size(); ++i) {
+        EXPECT_EQ(index_measurements.get_headers()[i].module,
+                  measurements.get_headers()[i].module);
+        ASSERT_EQ(index_measurements.get_items()[i].size(),
+                  measurements.get_items()[i].size());
+        for (std::size_t j = 0; j < measurements.get_items()[i].size(); ++j) {
+            EXPECT_EQ(index_measurements.get_items()[i][j],
+                      measurements.get_items()[i][j]);
+            EXPECT_EQ(index_measurements.get_items()[i][j].cluster_link,
+                      measurements.get_items()[i][j].cluster_link);
+        }
+    }
+}
+
+TEST(cluster_indices, device_access) {
+
+    // Memory resource used in the test.
+    vecmem::host_memory_resource resource;
+    const traccc::cell_container_types::host cells = make_cells(resource);
+
+    traccc::component_connection cc(resource);
+    const traccc::cluster_index_types::host indices = cc.cluster_indices(cells);
+
+    // Access the clusters through their (constant) device type.
+    const traccc::cluster_index_types::const_view view = get_data(indices);
+    const traccc::cluster_index_types::const_device device(view);
+    ASSERT_EQ(device.size(), indices.size());
+    for (unsigned int i = 0; i < device.size(); ++i) {
+        EXPECT_EQ(device.module_link(i), indices.module_links[i]);
+        ASSERT_EQ(device.n_cells(i), indices.n_cells(i));
+        const auto& module_cells =
+            cells.get_items()[device.module_link(i)];
+        const auto cluster = device.cells(module_cells, i);
+        const auto host_cluster = indices.cells(cells, i);
+        unsigned int j = 0;
+        for (const traccc::cell& c : cluster) {
+            EXPECT_EQ(c, host_cluster[j]);
+            EXPECT_EQ(cluster.index(j), host_cluster.index(j));
+            ++j;
+        }
+        EXPECT_EQ(j, device.n_cells(i));
+    }
+}
@@ -0,0 +1,130 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2022 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+// Project include(s).
+#include "traccc/clusterization/clusterization_algorithm.hpp"
+#include "traccc/clusterization/fast_sv_clusterization.hpp"
+#include "traccc/clusterization/spacepoint_formation.hpp"
+#include "traccc/edm/cell.hpp"
+#include "traccc/edm/measurement.hpp"
+#include "traccc/edm/spacepoint.hpp"
+#include "traccc/utils/event_batching.hpp"
+
+// VecMem include(s).
+#include <vecmem/memory/host_memory_resource.hpp>
+
+// GTest include(s).
+#include <gtest/gtest.h>
+
+// System include(s).
+#include <vector>
+
+TEST(event_batching, same_as_single_events) {
+
+    // Memory resource used in the test.
+    vecmem::host_memory_resource resource;
+
+    traccc::clusterization_algorithm ca(resource);
+    traccc::spacepoint_formation sf(resource);
+
+    const traccc::cell_collection_types::host cells_per_module = {
+        {{1, 0, 1., 0.},
+         {8, 4, 2., 0.},
+         {10, 4, 3., 0.},
+         {9, 5, 4., 0.},
+         {10, 5, 5., 0},
+         {12, 12, 6, 0},
+         {3, 13, 7, 0},
+         {11, 13, 8, 0},
+         {4, 14, 9, 0}},
+        &resource};
+
+    // Events with different numbers of modules, one of them empty. The
+    // module IDs of the events overlap, the last module of an event being
+    // the same as the first module of the next one.
+    std::vector<traccc::cell_container_types::host> events;
+    for (std::size_t e = 0; e < 4; ++e) {
+        traccc::cell_container_types::host cells(&resource);
+        for (std::size_t i = 0; i < ((e == 2) ? 0 : e + 1); ++i) {
+            traccc::cell_module module;
+            module.module = e + i;
+            module.threshold = 2.5f * i;
+            module.pixel = {-1.f * e, 2.f * i, 0.05f * (i + 1), 0.1f};
+            cells.push_back(module, cells_per_module);
+        }
+        events.push_back(cells);
+    }
+
+    // Process all events in one go
+    const traccc::cell_container_types::host batch =
+        traccc::batch_events(events, resource);
+    ASSERT_EQ(batch.size(), 1u + 2u + 4u);
+    const traccc::measurement_container_types::host measurements = ca(batch);
+    const traccc::spacepoint_container_types::host spacepoints =
+        sf(measurements);
+
+    // Split the results into the events
+    const std::vector<std::size_t> ranges =
+        traccc::event_ranges(measurements.get_headers(), events.size());
+    const std::vector<traccc::measurement_container_types::host>
+        measurements_per_event =
+            traccc::split_events(measurements, ranges, resource);
+    const std::vector<traccc::spacepoint_container_types::host>
+        spacepoints_per_event =
+            traccc::split_events(spacepoints, ranges, resource);
+    ASSERT_EQ(measurements_per_event.size(), events.size());
+
+    // The partitioned FastSV clusterization must number the clusters of
+    // the events in the same way.
+    traccc::fast_sv_clusterization fast_sv(resource);
+    const std::vector<traccc::measurement_container_types::host>
+        fast_sv_measurements_per_event =
+            traccc::split_events(fast_sv(batch), ranges, resource);
+    ASSERT_EQ(fast_sv_measurements_per_event.size(), events.size());
+    ASSERT_EQ(spacepoints_per_event.size(), events.size());
+
+    // Compare with processing the events one by one
+    for (std::size_t e = 0; e < events.size(); ++e) {
+        const traccc::measurement_container_types::host event_measurements =
+            ca(events[e]);
+        const traccc::spacepoint_container_types::host event_spacepoints =
+            sf(event_measurements);
+
+        ASSERT_EQ(event_measurements.size(), measurements_per_event[e].size());
+        ASSERT_EQ(event_spacepoints.size(), spacepoints_per_event[e].size());
+        for (std::size_t i = 0; i < event_measurements.size(); ++i) {
+            EXPECT_EQ(measurements_per_event[e].get_headers()[i].event, e);
+            EXPECT_EQ(event_measurements.get_headers()[i].module,
+                      measurements_per_event[e].get_headers()[i].module);
+            EXPECT_EQ(event_measurements.get_items()[i],
+                      measurements_per_event[e].get_items()[i]);
+            EXPECT_EQ(event_spacepoints.get_headers()[i],
+                      spacepoints_per_event[e].get_headers()[i]);
+            EXPECT_EQ(event_spacepoints.get_items()[i],
+                      spacepoints_per_event[e].get_items()[i]);
+
+            // The comparison operators ignore the cluster links.
+            const auto& single = event_measurements.get_items()[i];
+            const auto& split = measurements_per_event[e].get_items()[i];
+            const auto& fast_sv_split =
+                fast_sv_measurements_per_event[e].get_items()[i];
+            ASSERT_EQ(single.size(), split.size());
+            ASSERT_EQ(single.size(), fast_sv_split.size());
+            ASSERT_EQ(single.size(),
+                      spacepoints_per_event[e].get_items()[i].size());
+            for (std::size_t j = 0; j < single.size(); ++j) {
+                EXPECT_EQ(single[j].cluster_link, split[j].cluster_link);
+                EXPECT_EQ(single[j].cluster_link,
+                          fast_sv_split[j].cluster_link);
+                EXPECT_EQ(single[j].cluster_link,
+                          spacepoints_per_event[e]
+                              .get_items()[i][j]
+                              .meas.cluster_link);
+            }
+        }
+    }
+}
@@ -0,0 +1,94 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2022 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+// Project include(s).
+#include "traccc/clusterization/component_connection.hpp"
+#include "traccc/clusterization/fast_sv_clusterization.hpp"
+#include "traccc/clusterization/measurement_creation.hpp"
+#include "traccc/edm/cell.hpp"
+#include "traccc/edm/measurement.hpp"
+
+// VecMem include(s).
+#include <vecmem/memory/host_memory_resource.hpp>
+
+// GTest include(s).
+#include <gtest/gtest.h>
+
+// System include(s).
+#include <algorithm>
+#include <random>
+
+namespace {
+
+/// Create an event with modules of very different occupancies, big enough
+/// to be split into multiple partitions
+traccc::cell_container_types::host make_cells(vecmem::memory_resource& mr) {
+
+    std::mt19937 gen(42);
+    traccc::cell_container_types::host cells(&mr);
+    for (unsigned int i = 0; i < 50; ++i) {
+        traccc::cell_module module;
+        module.module = i;
+        module.threshold = (i % 3 == 0) ? 3.f : 0.f;
+        module.pixel = {-10.f, -20.f, 0.05f, 0.1f};
+
+        std::uniform_int_distribution<traccc::channel_id> channel(
+            0, 20 + i % 7 * 15);
+        std::uniform_int_distribution<unsigned int> activation(0, 9);
+        const unsigned int n_cells = (i % 10 == 0) ? 2000 : 1 + i * 3;
+        traccc::cell_collection_types::host module_cells(&mr);
+        for (unsigned int j = 0; j < n_cells; ++j) {
+            module_cells.push_back(
+                {channel(gen), channel(gen),
+                 static_cast<traccc::scalar>(activation(gen)), 0.});
+        }
+        std::stable_sort(module_cells.begin(), module_cells.end(),
+                         [](const traccc::cell& a, const traccc::cell& b) {
+                             return a.channel1 < b.channel1;
+                         });
+        cells.push_back(module, module_cells);
+    }
+    return cells;
+}
+
+}  // namespace
+
+TEST(fast_sv_clusterization, compare_with_component_connection) {
+
+    // Memory resource used in the test.
+    vecmem::host_memory_resource resource;
+
+    traccc::component_connection cc(resource);
+    traccc::measurement_creation mc(resource);
+    traccc::fast_sv_clusterization fast_sv(resource);
+    traccc::fast_sv_clusterization fast_sv_mt(
+        resource, traccc::clusterization_config{4});
+
+    const traccc::cell_container_types::host cells = make_cells(resource);
+    const auto reference = mc(cells, cc(cells));
+
+    // The results need to be identical, including their ordering
+    auto compare = [&reference](
+                       const traccc::measurement_container_types::host&
+                           measurements) {
+        ASSERT_EQ(reference.size(), measurements.size());
+        for (std::size_t i = 0; i < reference.size(); ++i) {
+            EXPECT_EQ(reference.at(i).header.module,
+                      measurements.at(i).header.module);
+            ASSERT_EQ(reference.at(i).items.size(),
+                      measurements.at(i).items.size());
+            for (std::size_t j = 0; j < reference.at(i).items.size(); ++j) {
+                EXPECT_EQ(reference.at(i).items[j],
+                          measurements.at(i).items[j]);
+                EXPECT_EQ(reference.at(i).items[j].cluster_link,
+                          measurements.at(i).items[j].cluster_link);
+            }
+        }
+    };
+    compare(fast_sv(cells));
+    compare(fast_sv_mt(cells));
+}
@@ -0,0 +1,160 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2022 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+// Project include(s).
+#include "traccc/clusterization/clusterization_algorithm.hpp"
+#include "traccc/clusterization/detail/linear_ccl.hpp"
+#include "traccc/clusterization/detail/sparse_ccl.hpp"
+#include "traccc/edm/cell.hpp"
+#include "traccc/edm/measurement.hpp"
+
+// VecMem include(s).
+#include <vecmem/memory/host_memory_resource.hpp>
+
+// GTest include(s).
+#include <gtest/gtest.h>
+
+// System include(s).
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+
+/// Create the cells of a strip module, sorted by channel0
+std::vector<traccc::cell> make_strip_cells(std::mt19937& gen) {
+
+    std::vector<traccc::cell> cells;
+    traccc::channel_id channel0 = gen() % 3;
+    const unsigned int n_cells = gen() % 200;
+    for (unsigned int i = 0; i < n_cells; ++i) {
+        cells.push_back({channel0, 0, static_cast<traccc::scalar>(gen() % 10),
+                         0.});
+        channel0 += gen() % 3;
+    }
+    return cells;
+}
+
+}  // namespace
+
+TEST(linear_ccl, same_as_sparse_ccl) {
+
+    std::mt19937 gen(42);
+    traccc::detail::linear_ccl_scratch scratch;
+    for (unsigned int event = 0; event < 100; ++event) {
+
+        std::vector<traccc::cell> cells = make_strip_cells(gen);
+        for (bool shuffle : {false, true}) {
+            if (shuffle) {
+                std::shuffle(cells.begin(), cells.end(), gen);
+            }
+
+            std::vector<unsigned int> sparse_labels(cells.size());
+            const unsigned int sparse_n =
+                traccc::detail::sparse_ccl(cells, sparse_labels);
+
+            std::vector<unsigned int> linear_labels(cells.size());
+            const unsigned int linear_n =
+                traccc::detail::linear_ccl(cells, linear_labels, scratch);
+
+            EXPECT_EQ(linear_n, sparse_n);
+            EXPECT_EQ(linear_labels, sparse_labels);
+        }
+    }
+}
+
+TEST(linear_ccl, strip_modules) {
+
+    // Memory resource used in the test.
+    vecmem::host_memory_resource resource;
+
+    // The same strip modules, once described as one-dimensional, and once
+    // as two-dimensional.
+    std::mt19937 gen(7);
+    traccc::cell_container_types::host cells_1d(&resource);
+    traccc::cell_container_types::host cells_2d(&resource);
+    for (std::size_t i = 0; i < 20; ++i) {
+        const std::vector<traccc::cell> cells = make_strip_cells(gen);
+        traccc::cell_module module;
+        module.module = i;
+        module.pixel = {-1.f, 0.f, 0.08f, 1.f, 1};
+        cells_1d.push_back(module, traccc::cell_collection_types::host{
+                                       cells.begin(), cells.end(), &resource});
+        module.pixel.dimension = 2;
+        cells_2d.push_back(module, traccc::cell_collection_types::host{
+                                       cells.begin(), cells.end(), &resource});
+    }
+
+    traccc::clusterization_algorithm ca(resource);
+    const traccc::measurement_container_types::host measurements_1d =
+        ca(cells_1d);
+    const traccc::measurement_container_types::host measurements_2d =
+        ca(cells_2d);
+
+    ASSERT_EQ(measurements_1d.size(), measurements_2d.size());
+    for (std::size_t i = 0; i < measurements_1d.size(); ++i) {
+        ASSERT_EQ(measurements_1d.get_items()[i].size(),
+                  measurements_2d.get_items()[i].size());
+        for (std::size_t j = 0; j < measurements_1d.get_items()[i].size();
+             ++j) {
+            EXPECT_EQ(measurements_1d.get_items()[i][j],
+                      measurements_2d.get_items()[i][j]);
+            EXPECT_EQ(measurements_1d.get_items()[i][j].cluster_link,
+                      measurements_2d.get_items()[i][j].cluster_link);
+        }
+    }
+}
+
+TEST(linear_ccl, multiple_columns) {
+
+    // Memory resource used in the test.
+    vecmem::host_memory_resource resource;
+
+    // One-dimensional modules with cells in more than one column need to be
+    // labelled like two-dimensional ones. (The columns are not neighbours,
+    // so their cells must not end up in the same clusters.)
+    std::mt19937 gen(11);
+    traccc::cell_container_types::host cells_1d(&resource);
+    traccc::cell_container_types::host cells_2d(&resource);
+    for (std::size_t i = 0; i < 20; ++i) {
+        std::vector<traccc::cell> cells = make_strip_cells(gen);
+        const std::vector<traccc::cell> column2 = make_strip_cells(gen);
+        for (traccc::cell c : column2) {
+            c.channel1 = 2;
+            cells.push_back(c);
+        }
+        EXPECT_EQ(traccc::detail::is_single_column(cells),
+                  (cells.size() == column2.size()) || column2.empty());
+        traccc::cell_module module;
+        module.module = i;
+        module.pixel = {-1.f, 0.f, 0.08f, 1.f, 1};
+        cells_1d.push_back(module, traccc::cell_collection_types::host{
+                                       cells.begin(), cells.end(), &resource});
+        module.pixel.dimension = 2;
+        cells_2d.push_back(module, traccc::cell_collection_types::host{
+                                       cells.begin(), cells.end(), &resource});
+    }
+
+    traccc::clusterization_algorithm ca(resource);
+    const traccc::measurement_container_types::host measurements_1d =
+        ca(cells_1d);
+    const traccc::measurement_container_types::host measurements_2d =
+        ca(cells_2d);
+
+    ASSERT_EQ(measurements_1d.size(), measurements_2d.size());
+    for (std::size_t i = 0; i < measurements_1d.size(); ++i) {
+        ASSERT_EQ(measurements_1d.get_items()[i].size(),
+                  measurements_2d.get_items()[i].size());
+        for (std::size_t j = 0; j < measurements_1d.get_items()[i].size();
+             ++j) {
+            EXPECT_EQ(measurements_1d.get_items()[i][j],
+                      measurements_2d.get_items()[i][j]);
+            EXPECT_EQ(measurements_1d.get_items()[i][j].cluster_link,
+                      measurements_2d.get_items()[i][j].cluster_link);
+        }
+    }
+}
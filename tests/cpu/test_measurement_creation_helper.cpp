@@ -0,0 +1,75 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2022 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+// Project include(s).
+#include "traccc/clusterization/detail/measurement_creation_helper.hpp"
+#include "traccc/definitions/common.hpp"
+#include "traccc/edm/cell.hpp"
+
+// VecMem include(s).
+#include <vecmem/memory/host_memory_resource.hpp>
+
+// GTest include(s).
+#include <gtest/gtest.h>
+
+// System include(s).
+#include <random>
+
+// Check that the fast paths for small clusters agree with the general
+// (Welford) calculation of the cluster properties
+TEST(measurement_creation_helper, small_cluster_fast_paths) {
+
+    // Memory resource used in the test.
+    vecmem::host_memory_resource resource;
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<traccc::channel_id> channel(0, 2);
+    std::uniform_real_distribution<traccc::scalar> activation(0., 10.);
+
+    for (unsigned int i = 0; i < 1000; ++i) {
+        traccc::cell_module module;
+        module.threshold = (i % 3 == 0) ? 3. : 0.;
+        module.pixel = {-20.f + i % 40, 10.f - i % 20, 0.05f, 0.055f};
+
+        // Create a small cluster of up to four cells.
+        traccc::cell_collection_types::host cluster(&resource);
+        const traccc::channel_id start0 = 100 + i, start1 = 200 + i;
+        for (unsigned int j = 0; j <= i % traccc::detail::small_cluster_size;
+             ++j) {
+            cluster.push_back({start0 + channel(gen), start1 + channel(gen),
+                               activation(gen), 0.});
+        }
+
+        traccc::scalar totalWeight = 0., totalWeight_fast = 0.;
+        traccc::point2 mean{0., 0.}, var{0., 0.};
+        traccc::point2 mean_fast{0., 0.}, var_fast{0., 0.};
+        traccc::detail::calc_cluster_properties(cluster, module, mean, var,
+                                                totalWeight);
+        if (cluster.size() == 1) {
+            traccc::detail::calc_single_cell_cluster_properties(
+                cluster[0], module, mean_fast, var_fast, totalWeight_fast);
+        } else if (cluster.size() == 2) {
+            traccc::detail::calc_two_cell_cluster_properties(
+                cluster[0], cluster[1], module, mean_fast, var_fast,
+                totalWeight_fast);
+        } else {
+            traccc::detail::calc_small_cluster_properties(
+                cluster, module, mean_fast, var_fast, totalWeight_fast);
+        }
+
+        ASSERT_EQ(totalWeight > 0., totalWeight_fast > 0.);
+        if (totalWeight > 0.) {
+            EXPECT_NEAR(totalWeight, totalWeight_fast, traccc::float_epsilon);
+            for (std::size_t j = 0; j < 2; ++j) {
+                EXPECT_NEAR(mean[j], mean_fast[j], traccc::float_epsilon);
+                EXPECT_NEAR(var[j] / totalWeight,
+                            var_fast[j] / totalWeight_fast,
+                            traccc::float_epsilon);
+            }
+        }
+    }
+}
@@ -0,0 +1,678 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2022 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+// Project include(s).
+#include "traccc/edm/internal_spacepoint.hpp"
+#include "traccc/edm/spacepoint.hpp"
+#include "traccc/seeding/detail/seeding_config.hpp"
+#include "traccc/seeding/detail/spacepoint_grid.hpp"
+#include "traccc/seeding/detail/spacepoint_grid_soa.hpp"
+#include "traccc/seeding/detail/triplet.hpp"
+#include "traccc/seeding/doublet_finding.hpp"
+#include "traccc/seeding/doublet_finding_helper.hpp"
+#include "traccc/seeding/seed_filtering.hpp"
+#include "traccc/seeding/seed_finding.hpp"
+#include "traccc/seeding/seed_selecting_helper.hpp"
+#include "traccc/seeding/spacepoint_binning.hpp"
+#include "traccc/seeding/spacepoint_binning_helper.hpp"
+#include "traccc/seeding/triplet_finding.hpp"
+#include "traccc/seeding/triplet_finding_helper.hpp"
+
+// VecMem include(s).
+#include <vecmem/memory/host_memory_resource.hpp>
+
+// GTest include(s).
+#include <gtest/gtest.h>
+
+// System include(s).
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+
+/// Spacepoints of tracks from the beam line on four barrel layers, and of
+/// noise. Some of the spacepoints are copied in x and y into the other
+/// modules, so that spacepoints of exactly the same radius share grid bins.
+traccc::spacepoint_container_types::host make_spacepoints(
+    vecmem::memory_resource& mr) {
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<traccc::scalar> uniform(0., 1.);
+
+    traccc::spacepoint_container_types::host spacepoints(&mr);
+    const traccc::scalar radii[] = {34., 70., 116., 172.};
+    for (unsigned int layer = 0; layer < 4; ++layer) {
+        spacepoints.push_back(traccc::geometry_id(layer),
+                              vecmem::vector<traccc::spacepoint>(&mr));
+    }
+
+    for (unsigned int track = 0; track < 500; ++track) {
+        const traccc::scalar phi = -3.1 + 6.2 * uniform(gen);
+        const traccc::scalar cot_theta = -3. + 6. * uniform(gen);
+        const traccc::scalar z0 = -100. + 200. * uniform(gen);
+        const traccc::scalar radius = 1000. + 20000. * uniform(gen);
+        const traccc::scalar charge = uniform(gen) < 0.5 ? -1. : 1.;
+        for (unsigned int layer = 0; layer < 4; ++layer) {
+            const traccc::scalar r = radii[layer];
+            const traccc::scalar sp_phi =
+                phi + charge * std::asin(r / (2. * radius));
+            traccc::spacepoint sp;
+            sp.global = {r * std::cos(sp_phi), r * std::sin(sp_phi),
+                         z0 + cot_theta * r};
+            spacepoints.get_items()[layer].push_back(sp);
+        }
+    }
+    for (unsigned int noise = 0; noise < 500; ++noise) {
+        const unsigned int layer = gen() % 4;
+        const traccc::scalar r = radii[layer] + 10. * uniform(gen);
+        const traccc::scalar phi = -3.1 + 6.2 * uniform(gen);
+        const traccc::scalar z = -1000. + 2000. * uniform(gen);
+        traccc::spacepoint sp;
+        sp.global = {r * std::cos(phi), r * std::sin(phi), z};
+        spacepoints.get_items()[layer].push_back(sp);
+        // Copy of the spacepoint in a lower module, a bit away in z.
+        if (layer > 0) {
+            sp.global[2] += 1.;
+            spacepoints.get_items()[layer - 1].push_back(sp);
+        }
+    }
+
+    return spacepoints;
+}
+
+/// Seed finder configuration with the derived parameters set up, the same
+/// way as in compare_with_acts_seeding
+traccc::seedfinder_config make_finder_config() {
+
+    traccc::seedfinder_config config;
+    traccc::seedfinder_config config_copy = config.toInternalUnits();
+    config.highland = 13.6 * std::sqrt(config_copy.radLengthPerSeed) *
+                      (1 + 0.038 * std::log(config_copy.radLengthPerSeed));
+    float maxScatteringAngle = config.highland / config_copy.minPt;
+    config.maxScatteringAngle2 = maxScatteringAngle * maxScatteringAngle;
+    config.pTPerHelixRadius = 300. * config_copy.bFieldInZ;
+    config.minHelixDiameter2 =
+        std::pow(config_copy.minPt * 2 / config.pTPerHelixRadius, 2);
+    config.pT2perRadius =
+        std::pow(config.highland / config.pTPerHelixRadius, 2);
+    return config;
+}
+
+/// Grid configuration matching a seed finder configuration
+traccc::spacepoint_grid_config make_grid_config(
+    const traccc::seedfinder_config& config) {
+
+    traccc::spacepoint_grid_config grid_config;
+    grid_config.bFieldInZ = config.bFieldInZ;
+    grid_config.minPt = config.minPt;
+    grid_config.rMax = config.rMax;
+    grid_config.zMax = config.zMax;
+    grid_config.zMin = config.zMin;
+    grid_config.deltaRMax = config.deltaRMax;
+    grid_config.cotThetaMax = config.cotThetaMax;
+    return grid_config;
+}
+
+/// Grid filled the way it was before the counting pass: all spacepoints
+/// in radius bins first, then moved into the grid one radius bin after
+/// the other.
+traccc::sp_grid reference_grid(
+    const traccc::seedfinder_config& finder_config,
+    const traccc::spacepoint_grid_config& grid_config,
+    const traccc::spacepoint_container_types::host& spacepoints,
+    vecmem::memory_resource& mr) {
+
+    const traccc::seedfinder_config config = finder_config.toInternalUnits();
+    auto axes = traccc::get_axes(grid_config.toInternalUnits(), mr);
+    traccc::sp_grid g2(axes.first, axes.second, mr);
+
+    std::vector<std::vector<traccc::internal_spacepoint<traccc::spacepoint>>>
+        r_bins(config.get_num_rbins());
+    for (std::size_t i = 0; i < spacepoints.size(); ++i) {
+        for (std::size_t j = 0; j < spacepoints.get_items()[i].size(); ++j) {
+            const std::size_t r_index =
+                traccc::is_valid_sp(config, spacepoints.get_items()[i][j]);
+            if (r_index != detray::detail::invalid_value<std::size_t>()) {
+                r_bins[r_index].emplace_back(spacepoints, std::make_pair(i, j),
+                                             config.beamPos);
+            }
+        }
+    }
+    for (auto& r_bin : r_bins) {
+        for (auto& isp : r_bin) {
+            traccc::point2 sp_position = {isp.phi(), isp.z()};
+            g2.populate(sp_position, std::move(isp));
+        }
+    }
+    return g2;
+}
+
+/// Weight increase of the triplets for their compatible seeds, comparing
+/// every triplet of <tt>[first, triplets.size())</tt> with every other one
+/// of that range, like the triplet finding used to
+void reference_seed_weights(const traccc::sp_grid& g2,
+                            traccc::triplet_collection_types::host& triplets,
+                            std::size_t first,
+                            const traccc::seedfilter_config& filter_config) {
+
+    for (std::size_t i = first; i < triplets.size(); ++i) {
+        auto& current_triplet = triplets[i];
+        const auto& spT_idx = current_triplet.sp3;
+        const traccc::scalar currentTop_r =
+            g2.bin(spT_idx.bin_idx)[spT_idx.sp_idx].radius();
+
+        std::vector<traccc::scalar> compatibleSeedR;
+        const traccc::scalar lowerLimitCurv =
+            current_triplet.curvature - filter_config.deltaInvHelixDiameter;
+        const traccc::scalar upperLimitCurv =
+            current_triplet.curvature + filter_config.deltaInvHelixDiameter;
+
+        for (std::size_t j = first; j < triplets.size(); ++j) {
+            if (i == j) {
+                continue;
+            }
+            const auto& other_triplet = triplets[j];
+            const auto& other_spT_idx = other_triplet.sp3;
+            const traccc::scalar otherTop_r =
+                g2.bin(other_spT_idx.bin_idx)[other_spT_idx.sp_idx].radius();
+            if (std::abs(currentTop_r - otherTop_r) <
+                filter_config.deltaRMin) {
+                continue;
+            }
+            if ((other_triplet.curvature < lowerLimitCurv) ||
+                (other_triplet.curvature > upperLimitCurv)) {
+                continue;
+            }
+
+            bool newCompSeed = true;
+            for (traccc::scalar previousDiameter : compatibleSeedR) {
+                if (std::abs(previousDiameter - otherTop_r) <
+                    filter_config.deltaRMin) {
+                    newCompSeed = false;
+                    break;
+                }
+            }
+            if (newCompSeed) {
+                compatibleSeedR.push_back(otherTop_r);
+                current_triplet.weight += filter_config.compatSeedWeight;
+            }
+            if (compatibleSeedR.size() >= filter_config.compatSeedLimit) {
+                break;
+            }
+        }
+    }
+}
+
+/// Seeds of the triplets of one middle spacepoint, sorting all of them
+/// before selecting the best ones, like the seed filtering used to
+void reference_seed_filtering(
+    const traccc::spacepoint_container_types::host& sp_container,
+    const traccc::sp_grid& g2,
+    traccc::triplet_collection_types::host& triplets,
+    const traccc::seedfilter_config& filter_config,
+    traccc::seed_collection_types::host& seeds) {
+
+    std::vector<traccc::seed> seeds_per_spM;
+    for (traccc::triplet& triplet : triplets) {
+        const auto& spB = g2.bin(triplet.sp1.bin_idx)[triplet.sp1.sp_idx];
+        const auto& spM = g2.bin(triplet.sp2.bin_idx)[triplet.sp2.sp_idx];
+        const auto& spT = g2.bin(triplet.sp3.bin_idx)[triplet.sp3.sp_idx];
+        traccc::seed_selecting_helper::seed_weight(filter_config, spM, spB,
+                                                   spT, triplet.weight);
+        if (!traccc::seed_selecting_helper::single_seed_cut(
+                filter_config, spM, spB, spT, triplet.weight)) {
+            continue;
+        }
+        seeds_per_spM.push_back({spB.m_link, spM.m_link, spT.m_link,
+                                 triplet.weight, triplet.z_vertex});
+    }
+
+    // Seeds of equal weight and equal yz-sum stay in their original order.
+    auto yz_sum = [&](const traccc::seed& s) {
+        const auto& spB = sp_container.at(s.spB_link);
+        const auto& spT = sp_container.at(s.spT_link);
+        traccc::scalar sum = 0;
+        sum += std::pow(spB.y(), 2) + std::pow(spB.z(), 2);
+        sum += std::pow(spT.y(), 2) + std::pow(spT.z(), 2);
+        return sum;
+    };
+    std::stable_sort(seeds_per_spM.begin(), seeds_per_spM.end(),
+                     [&](const traccc::seed& seed1, const traccc::seed& seed2) {
+                         if (seed1.weight != seed2.weight) {
+                             return seed1.weight > seed2.weight;
+                         }
+                         return yz_sum(seed1) > yz_sum(seed2);
+                     });
+
+    if (seeds_per_spM.size() > 1) {
+        std::vector<traccc::seed> new_seeds = {seeds_per_spM[0]};
+        const std::size_t n = std::min(seeds_per_spM.size(),
+                                       filter_config.max_triplets_per_spM);
+        for (std::size_t i = 1; i < n; ++i) {
+            if (traccc::seed_selecting_helper::cut_per_middle_sp(
+                    filter_config, sp_container, seeds_per_spM[i],
+                    seeds_per_spM[i].weight)) {
+                new_seeds.push_back(seeds_per_spM[i]);
+            }
+        }
+        seeds_per_spM = new_seeds;
+    }
+
+    std::size_t max_seeds = seeds_per_spM.size();
+    if (max_seeds > filter_config.maxSeedsPerSpM) {
+        max_seeds = filter_config.maxSeedsPerSpM + 1;
+    }
+    for (std::size_t i = 0; i < max_seeds; ++i) {
+        seeds.push_back(seeds_per_spM[i]);
+    }
+}
+
+}  // namespace
+
+// The spacepoints of every grid bin must be in the order of their radius
+// bin, and of their position in the container within one radius bin, since
+// the seed weights depend on that order.
+TEST(seeding, spacepoint_binning_order) {
+
+    vecmem::host_memory_resource resource;
+    const auto spacepoints = make_spacepoints(resource);
+
+    const traccc::seedfinder_config config;
+    const traccc::spacepoint_grid_config grid_config = make_grid_config(config);
+    const traccc::sp_grid reference =
+        reference_grid(config, grid_config, spacepoints, resource);
+
+    for (unsigned int n_threads : {1u, 3u}) {
+        traccc::spacepoint_binning binning(config, grid_config, resource,
+                                           n_threads);
+        const traccc::sp_grid g2 = binning(spacepoints);
+
+        ASSERT_EQ(g2.nbins(), reference.nbins());
+        for (unsigned int i = 0; i < g2.nbins(); ++i) {
+            ASSERT_EQ(g2.bin(i).size(), reference.bin(i).size());
+            for (unsigned int j = 0; j < g2.bin(i).size(); ++j) {
+                EXPECT_EQ(g2.bin(i)[j].m_link, reference.bin(i)[j].m_link);
+            }
+        }
+    }
+}
+
+// Searching only the radius window of the neighbour bins must find the same
+// doublets, in the same order, as checking all of their spacepoints.
+TEST(seeding, doublet_finding_radius_window) {
+
+    vecmem::host_memory_resource resource;
+    const auto spacepoints = make_spacepoints(resource);
+
+    const traccc::seedfinder_config config;
+    const traccc::spacepoint_grid_config grid_config = make_grid_config(config);
+    traccc::spacepoint_binning binning(config, grid_config, resource);
+    const traccc::sp_grid g2 = binning(spacepoints);
+
+    const traccc::seedfinder_config internal_config = config.toInternalUnits();
+    traccc::doublet_finding doublet_finding(internal_config);
+
+    std::size_t n_doublets = 0;
+    for (unsigned int i = 0; i < g2.nbins(); ++i) {
+        for (unsigned int j = 0; j < g2.bin(i).size(); ++j) {
+            const traccc::sp_location l = {i, j};
+            const auto& spM = g2.bin(i)[j];
+            for (bool bottom : {true, false}) {
+
+                const auto result = doublet_finding(g2, l, bottom);
+
+                std::vector<traccc::sp_location> expected;
+                auto phi_bins = g2.axis_p0().zone(
+                    spM.phi(), internal_config.neighbor_scope);
+                auto z_bins = g2.axis_p1().zone(
+                    spM.z(), internal_config.neighbor_scope);
+                for (auto& phi_bin : phi_bins) {
+                    for (auto& z_bin : z_bins) {
+                        const unsigned int bin_idx =
+                            phi_bin + z_bin * g2.axis_p0().bins();
+                        const auto& neighbors = g2.bin(bin_idx);
+                        for (unsigned int k = 0; k < neighbors.size(); ++k) {
+                            if (traccc::doublet_finding_helper::isCompatible(
+                                    spM, neighbors[k], internal_config,
+                                    bottom)) {
+                                expected.push_back({bin_idx, k});
+                            }
+                        }
+                    }
+                }
+
+                ASSERT_EQ(result.first.size(), expected.size());
+                ASSERT_EQ(result.second.size(), expected.size());
+                for (std::size_t k = 0; k < expected.size(); ++k) {
+                    EXPECT_EQ(result.first[k].sp1, l);
+                    EXPECT_EQ(result.first[k].sp2, expected[k]);
+                }
+                n_doublets += expected.size();
+            }
+        }
+    }
+    EXPECT_GT(n_doublets, 0u);
+}
+
+// The doublet finding on the structure-of-arrays description of the grid
+// must find exactly the same doublets as the one on the grid itself.
+TEST(seeding, doublet_finding_soa) {
+
+    vecmem::host_memory_resource resource;
+    const auto spacepoints = make_spacepoints(resource);
+
+    const traccc::seedfinder_config config;
+    const traccc::spacepoint_grid_config grid_config = make_grid_config(config);
+    traccc::spacepoint_binning binning(config, grid_config, resource, 3);
+    traccc::sp_grid_soa_types::host soa(&resource);
+    const traccc::sp_grid g2 = binning(spacepoints, soa);
+
+    // The description filled by the binning must be the same as a copy of
+    // the grid.
+    const traccc::sp_grid_soa_types::host copy(g2, &resource);
+    EXPECT_EQ(soa.bin_offsets, copy.bin_offsets);
+    EXPECT_EQ(soa.r_bins, copy.r_bins);
+    EXPECT_EQ(soa.r, copy.r);
+    EXPECT_EQ(soa.z, copy.z);
+
+    traccc::doublet_finding doublet_finding(config.toInternalUnits());
+
+    std::size_t n_doublets = 0;
+    for (unsigned int i = 0; i < g2.nbins(); ++i) {
+        for (unsigned int j = 0; j < g2.bin(i).size(); ++j) {
+            const traccc::sp_location l = {i, j};
+            for (bool bottom : {true, false}) {
+
+                const auto expected = doublet_finding(g2, l, bottom);
+                traccc::doublet_finding::output_type result;
+                doublet_finding(g2, soa, l, bottom, result);
+
+                ASSERT_EQ(result.first.size(), expected.first.size());
+                ASSERT_EQ(result.second.size(), expected.second.size());
+                for (std::size_t k = 0; k < expected.first.size(); ++k) {
+                    EXPECT_EQ(result.first[k], expected.first[k]);
+                    EXPECT_EQ(result.second[k].Zo(), expected.second[k].Zo());
+                    EXPECT_EQ(result.second[k].cotTheta(),
+                              expected.second[k].cotTheta());
+                    EXPECT_EQ(result.second[k].iDeltaR(),
+                              expected.second[k].iDeltaR());
+                    EXPECT_EQ(result.second[k].Er(), expected.second[k].Er());
+                    EXPECT_EQ(result.second[k].U(), expected.second[k].U());
+                    EXPECT_EQ(result.second[k].V(), expected.second[k].V());
+                }
+                n_doublets += expected.first.size();
+            }
+        }
+    }
+    EXPECT_GT(n_doublets, 0u);
+}
+
+// The seed finding must find the same seeds with and without the
+// structure-of-arrays description of the grid.
+TEST(seeding, seed_finding_soa) {
+
+    vecmem::host_memory_resource resource;
+    const auto spacepoints = make_spacepoints(resource);
+
+    const traccc::seedfinder_config config = make_finder_config();
+    const traccc::spacepoint_grid_config grid_config = make_grid_config(config);
+    traccc::spacepoint_binning binning(config, grid_config, resource);
+    traccc::sp_grid_soa_types::host soa(&resource);
+    const traccc::sp_grid g2 = binning(spacepoints, soa);
+
+    traccc::seed_finding seed_finding(config, traccc::seedfilter_config());
+    const auto expected = seed_finding(spacepoints, g2);
+    const auto result = seed_finding(spacepoints, g2, soa);
+
+    ASSERT_EQ(result.size(), expected.size());
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(result[i].spB_link, expected[i].spB_link);
+        EXPECT_EQ(result[i].spM_link, expected[i].spM_link);
+        EXPECT_EQ(result[i].spT_link, expected[i].spT_link);
+        EXPECT_EQ(result[i].weight, expected[i].weight);
+        EXPECT_EQ(result[i].z_vertex, expected[i].z_vertex);
+    }
+    EXPECT_GT(expected.size(), 0u);
+}
+
+// Checking only the middle-top doublets in the cotTheta window of every
+// middle-bottom doublet must find the same triplets, in the same order, as
+// checking all of them.
+TEST(seeding, triplet_finding_cot_theta_window) {
+
+    vecmem::host_memory_resource resource;
+    const auto spacepoints = make_spacepoints(resource);
+
+    const traccc::seedfinder_config config = make_finder_config();
+    const traccc::spacepoint_grid_config grid_config = make_grid_config(config);
+    traccc::spacepoint_binning binning(config, grid_config, resource);
+    const traccc::sp_grid g2 = binning(spacepoints);
+
+    const traccc::seedfinder_config internal_config = config.toInternalUnits();
+    traccc::doublet_finding doublet_finding(internal_config);
+    traccc::triplet_finding triplet_finding(internal_config);
+    traccc::triplet_finding_scratch scratch;
+
+    std::size_t n_triplets = 0;
+    for (unsigned int i = 0; i < g2.nbins(); ++i) {
+        for (unsigned int j = 0; j < g2.bin(i).size(); ++j) {
+            const traccc::sp_location l = {i, j};
+            const auto& spM = g2.bin(i)[j];
+            const auto mid_bot = doublet_finding(g2, l, true);
+            const auto mid_top = doublet_finding(g2, l, false);
+            triplet_finding.sort_mid_top(mid_top.second, scratch);
+
+            for (std::size_t k = 0; k < mid_bot.first.size(); ++k) {
+                const traccc::lin_circle& lb = mid_bot.second[k];
+
+                traccc::triplet_collection_types::host result;
+                triplet_finding.find_compatible(g2, mid_bot.first[k], lb,
+                                                mid_top.first, mid_top.second,
+                                                result, scratch);
+
+                // Check all middle-top doublets, in their original order.
+                const traccc::scalar iSinTheta2 =
+                    1 + lb.cotTheta() * lb.cotTheta();
+                const traccc::scalar scatteringInRegion2 =
+                    internal_config.maxScatteringAngle2 * iSinTheta2 *
+                    internal_config.sigmaScattering *
+                    internal_config.sigmaScattering;
+                std::vector<std::pair<traccc::sp_location, traccc::scalar>>
+                    expected;
+                for (std::size_t t = 0; t < mid_top.first.size(); ++t) {
+                    traccc::scalar curvature, impact_parameter;
+                    if (traccc::triplet_finding_helper::isCompatible(
+                            spM, lb, mid_top.second[t], internal_config,
+                            iSinTheta2, scatteringInRegion2, curvature,
+                            impact_parameter)) {
+                        expected.push_back({mid_top.first[t].sp2, curvature});
+                    }
+                }
+
+                ASSERT_EQ(result.size(), expected.size());
+                for (std::size_t t = 0; t < expected.size(); ++t) {
+                    EXPECT_EQ(result[t].sp1, mid_bot.first[k].sp2);
+                    EXPECT_EQ(result[t].sp2, l);
+                    EXPECT_EQ(result[t].sp3, expected[t].first);
+                    EXPECT_EQ(result[t].curvature, expected[t].second);
+                }
+                n_triplets += expected.size();
+            }
+        }
+    }
+    EXPECT_GT(n_triplets, 0u);
+}
+
+// The weight increase for compatible seeds, found in the curvature window
+// of every triplet, must be the same as when comparing all pairs of
+// triplets. Also for curvatures exactly at the edges of the windows.
+TEST(seeding, triplet_finding_compatible_seed_weights) {
+
+    vecmem::host_memory_resource resource;
+    const auto spacepoints = make_spacepoints(resource);
+
+    const traccc::seedfinder_config config = make_finder_config();
+    const traccc::spacepoint_grid_config grid_config = make_grid_config(config);
+    traccc::spacepoint_binning binning(config, grid_config, resource);
+    const traccc::sp_grid g2 = binning(spacepoints);
+    std::vector<traccc::sp_location> locations;
+    for (unsigned int i = 0; i < g2.nbins(); ++i) {
+        for (unsigned int j = 0; j < g2.bin(i).size(); ++j) {
+            locations.push_back({i, j});
+        }
+    }
+
+    // The triplet finding uses the default filter configuration.
+    const traccc::seedfilter_config filter_config;
+    const traccc::scalar delta = filter_config.deltaInvHelixDiameter;
+    traccc::triplet_finding triplet_finding(config.toInternalUnits());
+    traccc::triplet_finding_scratch scratch;
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<traccc::scalar> uniform(0., 1.);
+    for (unsigned int trial = 0; trial < 200; ++trial) {
+
+        // Triplets with curvatures equal to, or exactly at the window edges
+        // of other triplets, with top spacepoints of random radii.
+        traccc::triplet_collection_types::host triplets;
+        const unsigned int n_triplets = gen() % 40;
+        for (unsigned int k = 0; k < n_triplets; ++k) {
+            traccc::scalar curvature = 0.002 * uniform(gen) - 0.001;
+            if ((k > 0) && (gen() % 4 != 0)) {
+                const traccc::scalar other = triplets[gen() % k].curvature;
+                switch (gen() % 3) {
+                    case 0:
+                        curvature = other;
+                        break;
+                    case 1:
+                        curvature = other - delta;
+                        break;
+                    default:
+                        curvature = other + delta;
+                }
+            }
+            triplets.push_back({locations[gen() % locations.size()],
+                                locations[gen() % locations.size()],
+                                locations[gen() % locations.size()], curvature,
+                                uniform(gen), 0.});
+        }
+        const std::size_t first =
+            (trial % 2 == 0) ? 0 : gen() % (n_triplets + 1);
+
+        traccc::triplet_collection_types::host expected = triplets;
+        reference_seed_weights(g2, expected, first, filter_config);
+        triplet_finding.compatible_seed_weights(g2, triplets, first, scratch);
+
+        for (std::size_t k = 0; k < n_triplets; ++k) {
+            EXPECT_EQ(triplets[k].weight, expected[k].weight);
+        }
+    }
+
+    // The overload without scratch memory compares all triplets of its
+    // output, the ones of the previous middle-bottom doublets included.
+    traccc::doublet_finding doublet_finding(config.toInternalUnits());
+    std::size_t n_compared = 0;
+    for (unsigned int i = 0; i < g2.nbins(); i += 7) {
+        for (unsigned int j = 0; j < g2.bin(i).size(); ++j) {
+            const traccc::sp_location l = {i, j};
+            const auto mid_bot = doublet_finding(g2, l, true);
+            const auto mid_top = doublet_finding(g2, l, false);
+            triplet_finding.sort_mid_top(mid_top.second, scratch);
+
+            traccc::triplet_collection_types::host result, expected;
+            for (std::size_t k = 0; k < mid_bot.first.size(); ++k) {
+                triplet_finding(g2, mid_bot.first[k], mid_bot.second[k],
+                                mid_top.first, mid_top.second, result);
+                triplet_finding.find_compatible(
+                    g2, mid_bot.first[k], mid_bot.second[k], mid_top.first,
+                    mid_top.second, expected, scratch);
+                reference_seed_weights(g2, expected, 0, filter_config);
+            }
+
+            ASSERT_EQ(result.size(), expected.size());
+            for (std::size_t k = 0; k < expected.size(); ++k) {
+                EXPECT_EQ(result[k], expected[k]);
+                EXPECT_EQ(result[k].weight, expected[k].weight);
+            }
+            n_compared += expected.size();
+        }
+    }
+    EXPECT_GT(n_compared, 0u);
+}
+
+// Sorting only the best max_triplets_per_spM seeds must select the same
+// seeds, in the same order, as sorting all of them. Also without any
+// triplets to consider, for a single seed, and for seeds of equal weight
+// and equal yz-sum.
+TEST(seeding, seed_filtering_top_k) {
+
+    vecmem::host_memory_resource resource;
+    const auto spacepoints = make_spacepoints(resource);
+
+    const traccc::seedfinder_config config = make_finder_config();
+    const traccc::spacepoint_grid_config grid_config = make_grid_config(config);
+    traccc::spacepoint_binning binning(config, grid_config, resource);
+    const traccc::sp_grid g2 = binning(spacepoints);
+    std::vector<traccc::sp_location> locations;
+    for (unsigned int i = 0; i < g2.nbins(); ++i) {
+        for (unsigned int j = 0; j < g2.bin(i).size(); ++j) {
+            locations.push_back({i, j});
+        }
+    }
+
+    std::mt19937 gen(42);
+    std::size_t n_seeds = 0;
+    for (unsigned int trial = 0; trial < 200; ++trial) {
+
+        // Triplets sharing their bottom and top spacepoints, and so their
+        // yz-sums, out of a few ones, with only a few different weights.
+        std::vector<traccc::sp_location> pool;
+        for (unsigned int k = 0; k < 4; ++k) {
+            pool.push_back(locations[gen() % locations.size()]);
+        }
+        const traccc::sp_location spM = locations[gen() % locations.size()];
+        traccc::triplet_collection_types::host triplets;
+        const unsigned int n_triplets = (trial < 20) ? trial % 3 : gen() % 30;
+        for (unsigned int k = 0; k < n_triplets; ++k) {
+            triplets.push_back({pool[gen() % pool.size()], spM,
+                                pool[gen() % pool.size()], 0.,
+                                100.f * static_cast<traccc::scalar>(gen() % 4),
+                                static_cast<traccc::scalar>(k)});
+        }
+
+        for (std::size_t max_triplets : {0u, 1u, 2u, 5u, 100u}) {
+            for (unsigned int max_seeds : {0u, 2u, 20u}) {
+                traccc::seedfilter_config filter_config;
+                filter_config.max_triplets_per_spM = max_triplets;
+                filter_config.maxSeedsPerSpM = max_seeds;
+
+                traccc::triplet_collection_types::host input = triplets;
+                traccc::seed_collection_types::host expected;
+                reference_seed_filtering(spacepoints, g2, input, filter_config,
+                                         expected);
+
+                input = triplets;
+                traccc::seed_collection_types::host result;
+                const traccc::seed_filtering seed_filtering(filter_config);
+                seed_filtering(spacepoints, g2, input, result);
+
+                ASSERT_EQ(result.size(), expected.size());
+                for (std::size_t k = 0; k < expected.size(); ++k) {
+                    EXPECT_EQ(result[k].spB_link, expected[k].spB_link);
+                    EXPECT_EQ(result[k].spM_link, expected[k].spM_link);
+                    EXPECT_EQ(result[k].spT_link, expected[k].spT_link);
+                    EXPECT_EQ(result[k].weight, expected[k].weight);
+                    EXPECT_EQ(result[k].z_vertex, expected[k].z_vertex);
+                }
+                n_seeds += expected.size();
+            }
+        }
+    }
+    EXPECT_GT(n_seeds, 0u);
+}
@@ -0,0 +1,82 @@
+/** TRACCC library, part of the ACTS project (R&D line)
+ *
+ * (c) 2022 CERN for the benefit of the ACTS project
+ *
+ * Mozilla Public License Version 2.0
+ */
+
+// Project include(s).
+#include "traccc/clusterization/clusterization_algorithm.hpp"
+#include "traccc/clusterization/streaming_clusterization.hpp"
+#include "traccc/edm/cell.hpp"
+#include "traccc/edm/measurement.hpp"
+
+// VecMem include(s).
+#include <vecmem/memory/host_memory_resource.hpp>
+
+// GTest include(s).
+#include <gtest/gtest.h>
+
+TEST(streaming_clusterization, same_as_full_event) {
+
+    // Memory resource used in the test.
+    vecmem::host_memory_resource resource;
+
+    const traccc::cell_collection_types::host cells_per_module = {
+        {{1, 0, 1., 0.},
+         {8, 4, 2., 0.},
+         {10, 4, 3., 0.},
+         {9, 5, 4., 0.},
+         {10, 5, 5., 0},
+         {12, 12, 6, 0},
+         {3, 13, 7, 0},
+         {11, 13, 8, 0},
+         {4, 14, 9, 0}},
+        &resource};
+
+    // Modules with different pixel geometries and thresholds, and an empty
+    // module in between
+    traccc::cell_container_types::host cells(&resource);
+    for (std::size_t i = 0; i < 4; ++i) {
+        traccc::cell_module module;
+        module.module = i;
+        module.threshold = 2.5f * i;
+        module.pixel = {-1.f * i, 2.f * i, 0.05f * (i + 1), 0.1f};
+        cells.push_back(module, (i == 2) ? traccc::cell_collection_types::host{
+                                               &resource}
+                                         : cells_per_module);
+    }
+
+    traccc::clusterization_algorithm ca(resource);
+    const traccc::measurement_container_types::host measurements = ca(cells);
+
+    traccc::streaming_clusterization sc(resource);
+    for (unsigned int event = 0; event < 2; ++event) {
+
+        // Feed the modules one by one.
+        std::size_t entry = 0;
+        for (std::size_t i = 0; i < cells.size(); ++i) {
+            const traccc::measurement_collection_types::host module_result =
+                sc(cells.get_headers()[i], cells.get_items()[i]);
+            if (cells.get_items()[i].empty()) {
+                EXPECT_TRUE(module_result.empty());
+                continue;
+            }
+            ASSERT_LT(entry, measurements.size());
+            ASSERT_EQ(module_result.size(),
+                      measurements.get_items()[entry].size());
+            for (std::size_t j = 0; j < module_result.size(); ++j) {
+                EXPECT_EQ(module_result[j], measurements.get_items()[entry][j]);
+                EXPECT_EQ(module_result[j].cluster_link,
+                          measurements.get_items()[entry][j].cluster_link);
+            }
+            ++entry;
+        }
+        EXPECT_EQ(entry, measurements.size());
+        EXPECT_EQ(sc.n_clusters(), 3 * 4u);
+
+        // Start counting the clusters again for the next event.
+        sc.reset();
+        EXPECT_EQ(sc.n_clusters(), 0u);
+    }
+}